@@ -0,0 +1,274 @@
+/* ast.c - PL/0 ﷨ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pl0.h"
+
+/*
+ * -aʱ﷨ֻ﷨Ϻ
+ * astgen()һcode[]ʹŻ̶ֻܿһʽ
+ * ȫһУ±껥ã鲻ʱӱ
+ * һͷš±0ʾս㡣
+ * ʽĽ;ɵһָLITLOD
+ * OPRSTOCALĽǲʱתJEQ~JLEJOD
+ * ӽɣϽṹN_SEQ͡
+ * ̽ڵǼǹʱͷ䣬table[].adrݴ±꣬CALa
+ * Ҳǽ±꣬ȫɺͳһڵַ̿ڵǼǺ
+ * ǰͱڲ̵á
+ */
+
+int ast_mode = 0;            /* ﷨ɴ */
+
+struct node {
+    unsigned char kind;      /* enum fctenum nodekind */
+    short l;                 /*  */
+    int a;                   /* ָaN_SEQͷΪβN_PROCΪݴСɺΪڵַ */
+    int x, y;                /* ӽ㣻N_SEQΪԪһN_PROCΪڲ */
+};
+
+static struct node *ast;     /*  */
+static int nnodes = 1;       /* ý0Ų */
+static int astsize;
+
+/* һ */
+int mknode(int kind, int l, int a, int x, int y) {
+    struct node *n;
+    
+    if (nnodes >= astsize) {
+        astsize = astsize ? astsize * 2 : 4096;
+        ast = realloc(ast, astsize * sizeof(struct node));
+        if (!ast) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+    }
+    n = &ast[nnodes];
+    n->kind = kind;
+    n->l = l;
+    n->a = a;
+    n->x = x;
+    n->y = y;
+    return nnodes++;
+}
+
+/*
+ * ۵-ffoldĲǳʱڱʱֱֵ
+ * ʱcode[]ĩβLITLITβıʽֻǵLIT
+ * ﷨ʱLIT㡣-AMAX~AMAXΪ0ʱ۵
+ * ʱ㣬LITĲʼAMAXΧڡ
+ */
+int fold_exprs = 0;          /* ۵ */
+int fold_conds = 0;          /* ֪ */
+
+/* ȡnxyĳֵc[]ǳʱ0 */
+static int constargs(int n, int x, int y, int c[]) {
+    int k, e;
+    
+    if (!opt_fold) {
+        return 0;
+    }
+    for (k = 0; k < n; k++) {
+        if (ast_mode) {
+            e = k == 0 ? x : y;
+            if (e == 0 || ast[e].kind != LIT) {
+                return 0;
+            }
+            c[k] = ast[e].a;
+        } else {
+            e = cx - n + k;
+            if (e < 0 || code[e].f != LIT) {
+                return 0;
+            }
+            c[k] = code[e].a;
+        }
+    }
+    if (!ast_mode) {
+        cx -= n;     /* ɾȥ */
+    }
+    return 1;
+}
+
+/* ֱָΪ͡xyΪӽĽ */
+int gennode(enum fct f, int l, int a, int x, int y) {
+    int c[2], v;
+    
+    if (f == OPR && a >= 1 && a <= 5 && constargs(a == 1 ? 1 : 2, x, y, c)) {
+        switch (a) {
+            case 1: v = -c[0]; break;
+            case 2: v = c[0] + c[1]; break;
+            case 3: v = c[0] - c[1]; break;
+            case 4: v = c[0] * c[1]; break;
+            default: v = c[1] != 0 ? c[0] / c[1] : AMAX + 1; break;
+        }
+        if (v >= -AMAX && v <= AMAX) {
+            fold_exprs++;
+            return gennode(LIT, 0, v, 0, 0);
+        }
+        /* ۵ָ */
+        if (!ast_mode) {
+            cx += a == 1 ? 1 : 2;
+        }
+    }
+    if (!ast_mode) {
+        gen(f, l, a);
+        return 0;
+    }
+    return mknode(f, l, a, x, y);
+}
+
+/*
+ * fΪʱתJEQ~JLEJODyֻڹϵȽϡ
+ * ֱɴʱתĵַ﷨ʱ㡣
+ * ǳʱ֪ʱת-1﷨Ϊ0
+ * 㲻ʱJMP﷨ΪJMP㣩
+ */
+int gencond(enum fct f, int x, int y) {
+    int c[2], holds;
+    
+    if (constargs(f == JOD ? 1 : 2, x, y, c)) {
+        switch (f) {
+            case JOD: holds = c[0] % 2 != 0; break;
+            case JEQ: holds = c[0] == c[1]; break;
+            case JNE: holds = c[0] != c[1]; break;
+            case JLT: holds = c[0] < c[1]; break;
+            case JGE: holds = c[0] >= c[1]; break;
+            case JGT: holds = c[0] > c[1]; break;
+            default:  holds = c[0] <= c[1]; break;
+        }
+        fold_conds++;
+        if (holds) {
+            return ast_mode ? 0 : -1;
+        }
+        f = JMP;
+        x = y = 0;
+    }
+    if (ast_mode) {
+        return mknode(f, 0, 0, x, y);
+    }
+    gen(f, 0, 0);
+    return cx - 1;
+}
+
+/* kӵN_SEQlistĩβͷkΪսʱ */
+int append(int list, int k) {
+    int s;
+    
+    if (k == 0) {
+        return list;
+    }
+    s = mknode(N_SEQ, 0, 0, k, 0);
+    if (list == 0) {
+        ast[s].a = s;
+        return s;
+    }
+    ast[ast[list].a].y = s;
+    ast[list].a = s;
+    return list;
+}
+
+/* д̽kݴСڲ */
+int setproc(int k, int size, int procs, int body) {
+    ast[k].a = size;
+    ast[k].x = body;
+    ast[k].y = procs;
+    return k;
+}
+
+static void lower(int k);
+
+/*
+ * kϵʱtargetnegateΪ1ʱΪʱת
+ * תָĵַ֪Ҫתʱ-1
+ */
+static int lowercond(int k, int target, int negate) {
+    struct node *n = &ast[k];
+    
+    if (k == 0 || n->kind == JMP) {
+        /* 㲻 */
+        if ((k == 0) == negate) {
+            gen(JMP, 0, target);
+            return cx - 1;
+        }
+        return -1;
+    }
+    lower(n->x);
+    lower(n->y);
+    if (n->kind == JOD) {
+        gen(JOD, negate, target);
+    } else {
+        gen(JEQ + ((n->kind - JEQ) ^ negate), 0, target);  /* ȡϵ */
+    }
+    return cx - 1;
+}
+
+/* ɽkĴ */
+static void lower(int k) {
+    int j, top;
+    
+    if (k == 0) {
+        return;
+    }
+    switch (ast[k].kind) {
+        case N_SEQ:
+            for (; k != 0; k = ast[k].y) {
+                lower(ast[k].x);
+            }
+            break;
+        case N_IF:
+            j = lowercond(ast[k].x, 0, 0);
+            lower(ast[k].y);
+            if (j >= 0) {
+                code[j].a = cx;
+            }
+            break;
+        case N_WHILE:
+            /* ѭתsavecond()/restorecond()ɵĴͬ */
+            j = cx;
+            gen(JMP, 0, 0);
+            top = cx;
+            lower(ast[k].y);
+            code[j].a = cx;
+            lowercond(ast[k].x, top, 1);
+            break;
+        case N_PROC:
+            j = cx;
+            gen(JMP, 0, 0);
+            lower(ast[k].y);
+            code[j].a = cx;
+            gen(INT, 0, ast[k].a);
+            ast[k].a = cx - 1;
+            lower(ast[k].x);
+            gen(OPR, 0, 0);
+            break;
+        default:
+            lower(ast[k].x);
+            lower(ast[k].y);
+            gen(ast[k].kind, ast[k].l, ast[k].a);
+            break;
+    }
+}
+
+/* rootȫ룬ٻCALűй̵ڵַ */
+void astgen(int root) {
+    int k;
+    
+    lower(root);
+    for (k = 0; k < cx; k++) {
+        if (code[k].f == CAL) {
+            code[k].a = ast[code[k].a].a;
+        }
+    }
+    for (k = 1; k <= tx; k++) {
+        if (table[k].kind == PROCEDURE_SYM) {
+            table[k].adr = ast[table[k].adr].a;
+        }
+    }
+}
+
+/* һͷȫ */
+void astfree() {
+    free(ast);
+    ast = NULL;
+    nnodes = 1;
+    astsize = 0;
+}
@@ -0,0 +1,220 @@
+/* cfg.c - PL/0 ͼ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * Żõķ̵ĴڵINTJMPCALĿ꣩
+ * 𣬵һOPR 0ΪֹCALҳȫɴḶ́
+ * ̵ĲΪ߲μȥCALĲټһ
+ * Ϊ(Բ, ַ)ıšܿı̵ıֻ
+ * εڱ̵ģÿֻ¼õĹܸ̿д
+ * ȡġεıصͼٱ仯
+ * תĿתָ֮Ϊ׻ֻ飬ÿ̡
+ */
+
+struct proc procs[TXMAX];    /* ɴḶ́procs[0]Ϊ */
+int nprocs;
+int procat[CXMAX];           /* ԸõַΪڵḶ́-1ʾ */
+struct block blocks[CXMAX];  /* ǰ̵Ļ */
+int blockat[CXMAX];          /* ָڵĿ */
+
+static int vnum[LEVMAX + 1][TXMAX + 3];  /* ڵǰеżһ */
+int varids[CXMAX];           /* ŶӦı */
+static int nvars;
+
+/* code[k]ʵıkڹp */
+int varof(struct proc *p, int k) {
+    return VARID(p->level - code[k].l, code[k].a);
+}
+
+/* vڼsеλãʱΪӦλ */
+static int search(struct varset *s, int v) {
+    int lo = 0, hi = s->n, mid;
+    
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (s->v[mid] < v) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* vǷڼs */
+int inset(struct varset *s, int v) {
+    int k = search(s, v);
+    return k < s->n && s->v[k] == v;
+}
+
+/* ѱv뼯sԭûʱ1 */
+static int addvar(struct varset *s, int v) {
+    int k = search(s, v);
+    
+    if (k < s->n && s->v[k] == v) {
+        return 0;
+    }
+    if (s->n == s->size) {
+        s->size = s->size ? s->size * 2 : 4;
+        s->v = realloc(s->v, s->size * sizeof(int));
+        if (!s->v) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+    }
+    memmove(s->v + k + 1, s->v + k, (s->n - k) * sizeof(int));
+    s->v[k] = v;
+    s->n++;
+    return 1;
+}
+
+/* sвεlevı뼯d¼ķ1 */
+static int addouter(struct varset *d, struct varset *s, int lev) {
+    int k, changed = 0;
+    
+    for (k = 0; k < s->n; k++) {
+        if (VARLEV(s->v[k]) < lev) {
+            changed |= addvar(d, s->v[k]);
+        }
+    }
+    return changed;
+}
+
+/* ǼΪeΪlevḶ́ѵǼʱ */
+static void addproc(int e, int lev) {
+    struct proc *p;
+    
+    if (procat[e] >= 0 || nprocs >= TXMAX) {
+        return;
+    }
+    p = &procs[nprocs];
+    p->entry = e;
+    for (p->end = e; p->end < cx - 1 && !(code[p->end].f == OPR && code[p->end].a == 0); p->end++)
+        ;
+    p->level = lev;
+    memset(&p->mods, 0, sizeof(struct varset));
+    memset(&p->refs, 0, sizeof(struct varset));
+    procat[e] = nprocs++;
+}
+
+/* ҳȫɴĹ̼дȡϣع */
+int findprocs() {
+    struct proc *p, *q;
+    int j, k, changed;
+    
+    for (j = 0; j < nprocs; j++) {
+        free(procs[j].mods.v);
+        free(procs[j].refs.v);
+    }
+    nprocs = 0;
+    for (k = 0; k < cx; k++) {
+        procat[k] = -1;
+    }
+    addproc(code[0].a, 0);
+    for (j = 0; j < nprocs; j++) {
+        p = &procs[j];
+        for (k = p->entry; k <= p->end; k++) {
+            if (code[k].f == CAL) {
+                addproc(code[k].a, p->level - code[k].l + 1);
+            } else if ((code[k].f == STO || code[k].f == STK) && code[k].l > 0) {
+                addvar(&p->mods, varof(p, k));
+            } else if (code[k].f == LOD && code[k].l > 0) {
+                addvar(&p->refs, varof(p, k));
+            }
+        }
+    }
+    do {
+        changed = 0;
+        for (j = 0; j < nprocs; j++) {
+            p = &procs[j];
+            for (k = p->entry; k <= p->end; k++) {
+                if (code[k].f == CAL) {
+                    q = &procs[procat[code[k].a]];
+                    changed |= addouter(&p->mods, &q->mods, p->level);
+                    changed |= addouter(&p->refs, &q->refs, p->level);
+                }
+            }
+        }
+    } while (changed);
+    return nprocs;
+}
+
+/* pʵıţvarids[]Уر޷ʱ-1 */
+int numbervars(struct proc *p) {
+    int k, v;
+    
+    for (k = 0; k < nvars; k++) {
+        vnum[VARLEV(varids[k])][VARADR(varids[k])] = 0;
+    }
+    nvars = 0;
+    if (p->level > LEVMAX) {
+        return -1;
+    }
+    for (k = p->entry; k <= p->end; k++) {
+        if (code[k].f == LOD || code[k].f == STO || code[k].f == STK) {
+            v = varof(p, k);
+            if (code[k].l > p->level || code[k].a < 0 || code[k].a >= TXMAX + 3) {
+                return -1;
+            }
+            if (vnum[VARLEV(v)][VARADR(v)] == 0) {
+                varids[nvars++] = v;
+                vnum[VARLEV(v)][VARADR(v)] = nvars;
+            }
+        } else if (code[k].f >= STC) {
+            return -1;    /* ָ */
+        }
+    }
+    return nvars;
+}
+
+/* vڵǰе */
+int varno(int v) {
+    return vnum[VARLEV(v)][VARADR(v)] - 1;
+}
+
+/* ֹpĻ飬ؿ̵תʱ-1 */
+int buildblocks(struct proc *p) {
+    static char leader[CXMAX];
+    struct block *b;
+    int k, n = 0, last;
+    
+    memset(leader + p->entry, 0, p->end - p->entry + 1);
+    leader[p->entry] = 1;
+    for (k = p->entry; k <= p->end; k++) {
+        if (isjump(code[k].f)) {
+            if (code[k].a < p->entry || code[k].a > p->end) {
+                return -1;
+            }
+            leader[code[k].a] = 1;
+            if (k < p->end) {
+                leader[k + 1] = 1;
+            }
+        }
+    }
+    for (k = p->entry; k <= p->end; k++) {
+        if (leader[k]) {
+            if (n > 0) {
+                blocks[n - 1].end = k;
+            }
+            blocks[n].start = k;
+            n++;
+        }
+        blockat[k] = n - 1;
+    }
+    blocks[n - 1].end = p->end + 1;
+    for (b = blocks; b < blocks + n; b++) {
+        last = b->end - 1;
+        b->succ[0] = b->succ[1] = -1;
+        if (isjump(code[last].f)) {
+            b->succ[1] = blockat[code[last].a];
+        }
+        if (code[last].f != JMP && last < p->end) {
+            b->succ[0] = blockat[last + 1];
+        }
+    }
+    return n;
+}
@@ -0,0 +1,218 @@
+/* dce.c - PL/0 ɾ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * ȴcode[0]˳ִСתCALǿɴָ඼ɾȥ
+ * 򲻣ӣõĹɾȥֻڵͼϲɴĹ̵õ
+ * Ҳһ۵󲻻ִе͹ǰڲ̵JMPҲС
+ * ɴĩβOPR 0Ǳtier.cȷ̵ķΧ
+ * ÿ̵ĿͼԾĩβεڹ̵
+ * ǻԾģֲǣCAL̿ܶȡıǻԾġ
+ * ֮ٻԾıSTO洢ֵɿ
+ * LITLODûиãͬЩָһɾȥΪ
+ * INTֵɾȥLODʹĴ洢ҲΪ洢ظٱ仯
+ */
+
+#define LIVEMAX (1 << 24)    /* ÿ¼ĻԾλ */
+
+int dce_unreachable;         /* ɾȥĲɴָ */
+int dce_stores;              /* ɾȥ洢 */
+
+/* ɾȥcode[0]ɴָɾȥ */
+static int unreachable() {
+    static char reached[CXMAX];
+    static int work[CXMAX];
+    int nw = 0, k, n = 0;
+    
+    memset(reached, 0, cx);
+    reached[0] = 1;
+    work[nw++] = 0;
+    while (nw > 0) {
+        k = work[--nw];
+        if (code[k].f >= STC) {
+            return 0;    /* ָ */
+        }
+        /* ̣תõĿ꣬Լһָ */
+        if (isjump(code[k].f) || code[k].f == CAL) {
+            if (!reached[code[k].a]) {
+                reached[code[k].a] = 1;
+                work[nw++] = code[k].a;
+            }
+        }
+        if (code[k].f != JMP && !(code[k].f == OPR && code[k].a == 0) && k + 1 < cx
+            && !reached[k + 1]) {
+            reached[k + 1] = 1;
+            work[nw++] = k + 1;
+        }
+    }
+    findprocs();
+    for (k = 0; k < nprocs; k++) {
+        reached[procs[k].end] = 1;
+    }
+    for (k = 0; k < cx; k++) {
+        if (!reached[k]) {
+            discard(k);
+            n++;
+        }
+    }
+    return n;
+}
+
+/* code[k]ֵ[start, k)ûиʱstart򷵻-1 */
+static int valuestart(int k, int start) {
+    int need = 1, j;
+    
+    for (j = k - 1; j >= start; j--) {
+        switch (code[j].f) {
+            case LIT:
+            case LOD:
+                need--;
+                break;
+            case OPR:
+                if (code[j].a == 1 || code[j].a == 6) {
+                    break;
+                }
+                /* Ϊ0-1ʱгֻɾȥ */
+                if ((code[j].a >= 2 && code[j].a <= 4) || (code[j].a >= 8 && code[j].a <= 13)
+                    || (code[j].a == 5 && j - 1 >= start && code[j - 1].f == LIT && code[j - 1].a != 0
+                        && code[j - 1].a != -1)) {
+                    need++;
+                    break;
+                }
+                return -1;
+            default:
+                return -1;
+        }
+        if (need == 0) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+static int nv, w;            /* ǰ̵ıԾλͼֽ */
+static unsigned char *in;    /* ڵĻԾ */
+
+#define LIVE(v)    (live[(v) >> 3] & (1 << ((v) & 7)))
+#define SETLIVE(v) (live[(v) >> 3] |= 1 << ((v) & 7))
+#define KILL(v)    (live[(v) >> 3] &= ~(1 << ((v) & 7)))
+
+/*
+ * ӿbڵĻԾƵڣliveСrewriteʱɾȥ洢
+ * ɾȥָ
+ */
+static int transfer(struct proc *p, int b, unsigned char *live, int rewrite) {
+    int e, s, j, k, v, n = 0;
+    
+    memset(live, 0, w);
+    for (e = 0; e < 2; e++) {
+        s = blocks[b].succ[e];
+        if (s >= 0) {
+            for (j = 0; j < w; j++) {
+                live[j] |= in[(long long)s * w + j];
+            }
+        }
+    }
+    for (k = blocks[b].end - 1; k >= blocks[b].start; k--) {
+        switch (code[k].f) {
+            case LOD:
+                SETLIVE(varno(varof(p, k)));
+                break;
+            case STO:
+            case STK:
+                v = varno(varof(p, k));
+                if (rewrite && !LIVE(v)) {
+                    j = code[k].f == STO ? valuestart(k, blocks[b].start) : k;
+                    if (j >= 0) {
+                        for (; j <= k; j++) {
+                            discard(j);
+                            n++;
+                        }
+                    } else {
+                        code[k].f = INT;    /* ֵֻ */
+                        code[k].l = 0;
+                        code[k].a = -1;
+                    }
+                    dce_stores++;
+                }
+                KILL(v);
+                break;
+            case CAL:
+                for (j = 0; j < nv; j++) {
+                    if (inset(&procs[procat[code[k].a]].refs, varids[j])) {
+                        SETLIVE(j);
+                    }
+                }
+                break;
+            case OPR:
+                if (code[k].a == 0) {
+                    for (j = 0; j < nv; j++) {
+                        if (VARLEV(varids[j]) < p->level) {
+                            SETLIVE(j);
+                        }
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return n;
+}
+
+/* ڹpɾȥ洢ɾȥָ */
+static int deadstores(struct proc *p) {
+    unsigned char *live;
+    int nb, b, changed, n = 0;
+    
+    nb = buildblocks(p);
+    nv = numbervars(p);
+    if (nb < 0 || nv <= 0 || (long long)nb * (nv + 8) > LIVEMAX) {
+        return 0;
+    }
+    w = (nv + 7) / 8;
+    in = calloc((long long)nb * w, 1);
+    live = malloc(w);
+    if (!in || !live) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    do {
+        changed = 0;
+        for (b = nb - 1; b >= 0; b--) {
+            transfer(p, b, live, 0);
+            if (memcmp(live, in + (long long)b * w, w) != 0) {
+                memcpy(in + (long long)b * w, live, w);
+                changed = 1;
+            }
+        }
+    } while (changed);
+    for (b = 0; b < nb; b++) {
+        n += transfer(p, b, live, 1);
+    }
+    free(in);
+    free(live);
+    return n;
+}
+
+/* ɾȥ洢ɾȥָ */
+int dce() {
+    int j, n, removed;
+    
+    dce_stores = 0;
+    dce_unreachable = unreachable();
+    removed = compact();
+    do {
+        findprocs();
+        n = 0;
+        for (j = 0; j < nprocs; j++) {
+            n += deadstores(&procs[j]);
+        }
+        removed += compact();
+    } while (n > 0);
+    return removed;
+}
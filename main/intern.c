@@ -0,0 +1,116 @@
+/* intern.c - PL/0 ʶפ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * ÿͬıʶֻһݣʷݿĵַΪ
+ * бֲ䡣űֱԾΪȽֻȽָ롣
+ * ַηڴУ䣬Ӳͷţ
+ * פΪŶַɢбװһʱӱ˱ʱΪÿ
+ * ʶǺŷͷڴ档
+ * Դڱڼʼڴʱscan.cintern_span()һ
+ * ҲʡȥǱʶԴеһγֵλá
+ */
+
+#define ARENASIZE 65536      /* ÿֽ */
+
+struct islot {
+    char *s;                 /* פַNULLʾղ */
+    unsigned h;              /* ɢֵ */
+    int len;
+};
+
+static char *arena;          /* ǰĿв */
+static int arenaleft;        /* ǰʣֽ */
+static struct islot *slots;  /* פ */
+static int nslots;           /* 2 */
+static int nused;            /* ò */
+
+/* ַs[0..len)ɢֵ */
+static unsigned strhash(const char *s, int len) {
+    unsigned h = 2166136261u;
+    int k;
+    for (k = 0; k < len; k++) {
+        h = (h ^ (unsigned char)s[k]) * 16777619u;
+    }
+    return h;
+}
+
+/* зnֽ */
+static char *arenaalloc(int n) {
+    char *p;
+    if (n > arenaleft) {
+        int size = n > ARENASIZE ? n : ARENASIZE;
+        arena = malloc(size);
+        if (!arena) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+        arenaleft = size;
+    }
+    p = arena;
+    arena += n;
+    arenaleft -= n;
+    return p;
+}
+
+/* פӱԭеĴɢֵ· */
+static void grow() {
+    struct islot *old = slots;
+    int n = nslots, k, j;
+    
+    nslots = n ? n * 2 : 1024;
+    slots = calloc(nslots, sizeof(struct islot));
+    if (!slots) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (k = 0; k < n; k++) {
+        if (old[k].s) {
+            for (j = old[k].h & (nslots - 1); slots[j].s; j = (j + 1) & (nslots - 1))
+                ;
+            slots[j] = old[k];
+        }
+    }
+    free(old);
+}
+
+/* s[0..len)ûʱǼǣcopyΪ0ʱֱs */
+static char *lookup(const char *s, int len, int copy) {
+    unsigned h = strhash(s, len);
+    int j;
+    
+    if (2 * (nused + 1) > nslots) {
+        grow();
+    }
+    for (j = h & (nslots - 1); slots[j].s; j = (j + 1) & (nslots - 1)) {
+        if (slots[j].h == h && slots[j].len == len && memcmp(slots[j].s, s, len) == 0) {
+            return slots[j].s;
+        }
+    }
+    if (copy) {
+        slots[j].s = arenaalloc(len + 1);
+        memcpy(slots[j].s, s, len);
+        slots[j].s[len] = '\0';
+    } else {
+        slots[j].s = (char *)s;
+    }
+    slots[j].h = h;
+    slots[j].len = len;
+    nused++;
+    return slots[j].s;
+}
+
+/* s[0..len)פͬĴǷͬһַ */
+char *intern(const char *s, int len) {
+    return lookup(s, len, 1);
+}
+
+/* ͬintern()ֱָs[0..len)״γִ0β
+ * ڱڼʼЧԴ */
+char *intern_span(const char *s, int len) {
+    return lookup(s, len, 0);
+}
@@ -0,0 +1,186 @@
+/* io.c - PL/0  */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include "pl0.h"
+
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * WRITEд뻺READ֮ǰͳʱһ
+ * дstdoutÿprintfĸʽͼ0
+ * ʱֹǰҲдݲᶪʧ
+ * λһĲתprintf("%d ")ȫͬ
+ *
+ * READĬΪʽʾscanf롣ǽʽ²
+ * ʾͨļʱӳ䵽ڴ棬򰴴룬
+ * дĽַת
+ */
+
+#define OUTSIZE 65536
+#define INSIZE  65536
+
+int vm_batch;                /* ǽ */
+
+static char outbuf[OUTSIZE];
+static int outn;
+
+static FILE *infile;         /* ǽԴ */
+static char inbuf[INSIZE];
+static char *inp, *inend;    /* δ */
+static int inmapped;         /* ӳ */
+
+static const char digits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* ѻдstdout */
+void vm_flush() {
+    if (outn > 0) {
+        fwrite(outbuf, 1, outn, stdout);
+        outn = 0;
+    }
+}
+
+/* ʱдĬϷʽֹ */
+static void ontrap(int sig) {
+    vm_flush();
+    fflush(stdout);
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+/* ִǰװʱĴ */
+void vm_catch() {
+    signal(SIGFPE, ontrap);
+}
+
+/* xһո */
+void vm_write(int x) {
+    char tmp[12];
+    char *p = tmp + sizeof(tmp);
+    unsigned u = x < 0 ? 0u - (unsigned)x : (unsigned)x;
+    int n;
+    
+    if (outn > OUTSIZE - 16) {
+        vm_flush();
+    }
+    while (u >= 100) {
+        p -= 2;
+        memcpy(p, digits + u % 100 * 2, 2);
+        u /= 100;
+    }
+    if (u >= 10) {
+        p -= 2;
+        memcpy(p, digits + u * 2, 2);
+    } else {
+        *--p = (char)('0' + u);
+    }
+    if (x < 0) {
+        *--p = '-';
+    }
+    n = tmp + sizeof(tmp) - p;
+    memcpy(outbuf + outn, p, n);
+    outn += n;
+    outbuf[outn++] = ' ';
+}
+
+/*  */
+void vm_writeln() {
+    if (outn > OUTSIZE - 16) {
+        vm_flush();
+    }
+    outbuf[outn++] = '\n';
+}
+
+/* ÷ǽ룬nameΪNULLʱstdin򲻿0 */
+int vm_input(const char *name) {
+#if defined(__unix__)
+    struct stat st;
+    long pos;
+    char *map;
+#endif
+    
+    infile = name == NULL ? stdin : fopen(name, "r");
+    if (infile == NULL) {
+        return 0;
+    }
+    vm_batch = 1;
+    inp = inend = inbuf;
+    inmapped = 0;
+#if defined(__unix__)
+    /* ͨļֱӳ䣬stdioѶλÿʼ */
+    pos = ftell(infile);
+    if (fstat(fileno(infile), &st) == 0 && S_ISREG(st.st_mode) && pos >= 0 && st.st_size > pos) {
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(infile), 0);
+        if (map != MAP_FAILED) {
+            inp = map + pos;
+            inend = map + st.st_size;
+            inmapped = 1;
+        }
+    }
+#endif
+    return 1;
+}
+
+/* һ飬ʱ0 */
+static int fill() {
+    size_t n;
+    
+    if (inmapped) {
+        return 0;
+    }
+    n = fread(inbuf, 1, INSIZE, infile);
+    if (n == 0) {
+        return 0;
+    }
+    inp = inbuf;
+    inend = inbuf + n;
+    return 1;
+}
+
+#define PEEK() (inp < inend || fill() ? (unsigned char)*inp : -1)
+
+/* ǽʽһûɶʱΪ0 */
+static int readint() {
+    unsigned x = 0;
+    int c, neg = 0;
+    
+    while ((c = PEEK()) == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+        inp++;
+    }
+    if (c == '-' || c == '+') {
+        neg = (c == '-');
+        inp++;
+    }
+    while ((c = PEEK()) >= '0' && c <= '9') {
+        x = x * 10 + (c - '0');
+        inp++;
+    }
+    return neg ? (int)(0u - x) : (int)x;
+}
+
+/* һʽеݺʾ */
+int vm_read() {
+    int x = 0;
+    
+    if (vm_batch) {
+        return readint();
+    }
+    vm_flush();
+    printf("? ");
+    scanf("%d", &x);
+    return x;
+}
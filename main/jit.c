@@ -0,0 +1,557 @@
+/* jit.c - PL/0 x86-64 ģ弴ʱ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pl0.h"
+
+#if defined(__x86_64__) && defined(__unix__)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * ÿָ̶ģ巭Ϊ룬ʱ״̬һ£
+ *   rbx  &s[0]
+ *   r12  ջt
+ *   r13  ַb
+ *   r14  &display[0]
+ *   r15  ǰ
+ * ¼run_switch()ͬCALΪnative callOPR 0Ϊret
+ * ǰûջΡCɡ
+ * һα루run_jitҲ԰̷ֱ루ֲִУ
+ * ÿαµҳʼִеĴҳʼձִֿС
+ * ֲִʱδĹ̾tier_call()ص
+ * 켣ʱCALOPR 0͵չתΪƫ¼
+ * ʱɳڷӦ͵code[]ַ
+ */
+
+enum { RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+       R12 = 12, R13 = 13, R14 = 14, R15 = 15 };
+
+static unsigned char *buf;    /* 뻺 */
+static int bx;                /*  */
+static int bufsize;
+static int pagesize;
+static int noff[CXMAX + 1];   /* code[]ַӦĻƫƣδΪ-1 */
+static int tiered;            /* Ƿ񰴹̷ֲ */
+static int fixup[CXMAX];      /* rel32λ */
+static int fixtarget[CXMAX];  /* Ӧcode[]ַ */
+static int nfix;
+static int exitat[TRACEMAX];  /* 켣תrel32λ */
+static int exitpc[TRACEMAX];  /* ڴ͵code[]ַ */
+
+static void byte(int c) {
+    buf[bx++] = (unsigned char)c;
+}
+
+static void dword(int v) {
+    memcpy(buf + bx, &v, 4);
+    bx += 4;
+}
+
+static void qword(void *p) {
+    memcpy(buf + bx, &p, 8);
+    bx += 8;
+}
+
+/* op reg, [base + idx*4 + disp]w=1ʱΪ64λ */
+static void memop(int w, int op, int reg, int base, int idx, int disp) {
+    byte(0x40 | (w << 3) | ((reg >> 3) << 2) | ((idx >> 3) << 1) | (base >> 3));
+    if (op > 0xff) {
+        byte(op >> 8);
+    }
+    byte(op & 0xff);
+    byte(0x84 | ((reg & 7) << 3));
+    byte(0x80 | ((idx & 7) << 3) | (base & 7));
+    dword(disp);
+}
+
+/* s[t + k]s[b + k]display[lev - l] */
+#define ST(k)   RBX, R12, (k) * 4
+#define SB(k)   RBX, R13, (k) * 4
+#define DISP(l) R14, R15, -(l) * 4
+
+static void lea12(int k) {    /* lea r12, [r12 + k]Ӱ־λ */
+    byte(0x4d); byte(0x8d); byte(0x64); byte(0x24); byte(k);
+}
+
+static void call_c(void *f) {
+    byte(0x48); byte(0x89); byte(0xe5);              /* mov rbp, rsp */
+    byte(0x48); byte(0x83); byte(0xe4); byte(0xf0);  /* and rsp, -16 */
+    byte(0x48); byte(0xb8); qword(f);                /* mov rax, f */
+    byte(0xff); byte(0xd0);                          /* call rax */
+    byte(0x48); byte(0x89); byte(0xec);              /* mov rsp, rbp */
+}
+
+/* תcode[]ַtargetopΪrel32ʽĲ */
+static void jump(int op, int target) {
+    if (op > 0xff) {
+        byte(op >> 8);
+    }
+    byte(op & 0xff);
+    fixup[nfix] = bx;
+    fixtarget[nfix++] = target;
+    dword(0);
+}
+
+/* ȡlĵַַrcxl=0ʱֱr13 */
+static int varbase(int l) {
+    if (l == 0) {
+        return R13;
+    }
+    memop(1, 0x63, RCX, DISP(l));    /* movsxd rcx, display[lev - l] */
+    return RCX;
+}
+
+/* ʱתõjcc˳ͬJEQ~JLE */
+static int jfalse[] = { 0x0f85, 0x0f84, 0x0f8d, 0x0f8c, 0x0f8e, 0x0f8f };
+/* ϵʱλõsetcc˳ͬOPR 8~13 */
+static int setcc[] = { 0x0f94, 0x0f95, 0x0f9c, 0x0f9d, 0x0f9f, 0x0f9e };
+
+/* һָָԭָ */
+static void compile(int k) {
+    struct instruction *i = &code[k];
+    enum fct f = i->f;
+    int r;
+    
+    switch (f) {
+        case STC: f = LIT; break;
+        case UPD: case JVV: case JVC: f = LOD; break;
+        default: break;
+    }
+    
+    switch (f) {
+        case LIT:
+            lea12(1);
+            memop(0, 0xc7, 0, ST(0));  /* mov dword s[t], imm32 */
+            dword(i->a);
+            break;
+            
+        case LOD:
+            r = varbase(i->l);
+            memop(0, 0x8b, RAX, RBX, r, i->a * 4);
+            lea12(1);
+            memop(0, 0x89, RAX, ST(0));
+            break;
+            
+        case STO:
+            r = varbase(i->l);
+            memop(0, 0x8b, RAX, ST(0));
+            lea12(-1);
+            memop(0, 0x89, RAX, RBX, r, i->a * 4);
+            break;
+            
+        case STK:
+            r = varbase(i->l);
+            memop(0, 0x8b, RAX, ST(0));
+            memop(0, 0x89, RAX, RBX, r, i->a * 4);
+            break;
+            
+        case CAL:
+            byte(0x41); byte(0x57);                          /* push r15 */
+            if (i->l == 0) {
+                byte(0x49); byte(0xff); byte(0xc7);          /* inc r15 */
+            } else if (i->l > 1) {
+                byte(0x49); byte(0x81); byte(0xef); dword(i->l - 1);  /* sub r15, l-1 */
+            }
+            memop(0, 0x8b, RAX, DISP(0));
+            memop(0, 0x89, RAX, ST(1));                      /* s[t+1] = display[lev] */
+            memop(0, 0x89, R13, ST(2));                      /* s[t+2] = b */
+            memop(0, 0xc7, 0, ST(3));                        /* s[t+3] = صַ */
+            dword(k + 1);
+            byte(0x4d); byte(0x8d); byte(0x6c); byte(0x24); byte(0x01);  /* lea r13, [r12+1] */
+            memop(0, 0x89, R13, DISP(0));                    /* display[lev] = b */
+            if (!tiered || noff[i->a] >= 0) {
+                jump(0xe8, i->a);                            /* call */
+            } else {
+                /* δ룬ɽִУɺȡtb */
+                byte(0xbf); dword(i->a);                     /* mov edi, a */
+                byte(0x44); byte(0x89); byte(0xe6);          /* mov esi, r12d */
+                byte(0x44); byte(0x89); byte(0xea);          /* mov edx, r13d */
+                byte(0x44); byte(0x89); byte(0xf9);          /* mov ecx, r15d */
+                call_c((void *)tier_call);
+                byte(0x48); byte(0xb8); qword(&tier_regs);   /* mov rax, &tier_regs */
+                byte(0x4c); byte(0x63); byte(0x20);          /* movsxd r12, [rax] */
+                byte(0x4c); byte(0x63); byte(0x68); byte(4); /* movsxd r13, [rax+4] */
+            }
+            byte(0x41); byte(0x5f);                          /* pop r15 */
+            break;
+            
+        case INT:
+            byte(0x49); byte(0x81); byte(0xc4); dword(i->a);  /* add r12, a */
+            break;
+            
+        case JMP:
+            jump(0xe9, i->a);
+            break;
+            
+        case JPC:
+            memop(0, 0x8b, RAX, ST(0));
+            lea12(-1);
+            byte(0x85); byte(0xc0);                          /* test eax, eax */
+            jump(0x0f84, i->a);
+            break;
+            
+        case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+            memop(0, 0x8b, RAX, ST(-1));
+            memop(0, 0x3b, RAX, ST(0));                      /* cmp eax, s[t] */
+            lea12(-2);
+            jump(jfalse[f - JEQ], i->a);
+            break;
+            
+        case JOD:
+            memop(0, 0x8b, RAX, ST(0));
+            lea12(-1);
+            byte(0xa9); dword(1);                            /* test eax, 1 */
+            jump(i->l ? 0x0f85 : 0x0f84, i->a);
+            break;
+            
+        case SHL:
+            memop(0, 0xc1, 4, ST(0));                        /* shl dword s[t], a */
+            byte(i->a);
+            break;
+            
+        case SHR:
+            memop(0, 0x8b, RAX, ST(0));
+            byte(0x99);                                      /* cdq */
+            byte(0x81); byte(0xe2); dword((1 << i->a) - 1);  /* and edx, 2^a-1 */
+            byte(0x01); byte(0xd0);                          /* add eax, edx */
+            byte(0xc1); byte(0xf8); byte(i->a);              /* sar eax, a */
+            memop(0, 0x89, RAX, ST(0));
+            break;
+            
+        case DVM:
+            memop(0, 0x8b, RCX, ST(0));
+            byte(0x48); byte(0x63); byte(0xc1);              /* movsxd rax, ecx */
+            byte(0x48); byte(0x69); byte(0xc0); dword(i->a); /* imul rax, rax, a */
+            byte(0x48); byte(0xc1); byte(0xf8); byte(32);    /* sar rax, 32 */
+            if (i->a < 0) {
+                byte(0x01); byte(0xc8);                      /* add eax, ecx */
+            }
+            byte(0xc1); byte(0xf8); byte(i->l);              /* sar eax, l */
+            byte(0xc1); byte(0xe9); byte(31);                /* shr ecx, 31 */
+            byte(0x01); byte(0xc8);                          /* add eax, ecx */
+            memop(0, 0x89, RAX, ST(0));
+            break;
+            
+        case OPR:
+            switch (i->a) {
+                case 0:
+                    byte(0x4d); byte(0x8d); byte(0x65); byte(0xff);  /* lea r12, [r13-1] */
+                    memop(0, 0x8b, RAX, SB(0));
+                    memop(0, 0x89, RAX, DISP(0));            /* display[lev] = s[b] */
+                    memop(1, 0x63, R13, SB(1));              /* b = s[b+1] */
+                    byte(0xc3);                              /* ret */
+                    break;
+                case 1:
+                    memop(0, 0xf7, 3, ST(0));                /* neg s[t] */
+                    break;
+                case 2: case 3: case 4:
+                    memop(0, 0x8b, RAX, ST(-1));
+                    memop(0, i->a == 2 ? 0x03 : i->a == 3 ? 0x2b : 0x0faf, RAX, ST(0));
+                    memop(0, 0x89, RAX, ST(-1));
+                    lea12(-1);
+                    break;
+                case 5:
+                    memop(0, 0x8b, RAX, ST(-1));
+                    byte(0x99);                              /* cdq */
+                    memop(0, 0xf7, 7, ST(0));                /* idiv s[t] */
+                    memop(0, 0x89, RAX, ST(-1));
+                    lea12(-1);
+                    break;
+                case 6:
+                    memop(0, 0x83, 4, ST(0));                /* and dword s[t], 1 */
+                    byte(1);
+                    break;
+                case 8: case 9: case 10: case 11: case 12: case 13:
+                    memop(0, 0x8b, RCX, ST(-1));
+                    byte(0x31); byte(0xc0);                  /* xor eax, eax */
+                    memop(0, 0x3b, RCX, ST(0));
+                    byte(0x0f); byte(setcc[i->a - 8] & 0xff); byte(0xc0);  /* setcc al */
+                    memop(0, 0x89, RAX, ST(-1));
+                    lea12(-1);
+                    break;
+                case 14:
+                    memop(0, 0x8b, RDI, ST(0));
+                    lea12(-1);
+                    call_c((void *)vm_write);
+                    break;
+                case 15:
+                    call_c((void *)vm_writeln);
+                    break;
+                case 16:
+                    call_c((void *)vm_read);
+                    lea12(1);
+                    memop(0, 0x89, RAX, ST(0));
+                    break;
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/* 뻺ڣʧܷ0tierΪ1ʱ̷ֲ */
+int jit_init(int tier) {
+    int k;
+    
+    pagesize = sysconf(_SC_PAGESIZE);
+    bufsize = cx * 64 + (cx + 2) * pagesize;
+    buf = mmap(NULL, bufsize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED) {
+        return 0;
+    }
+    tiered = tier;
+    bx = nfix = 0;
+    for (k = 0; k <= cx; k++) {
+        noff[k] = -1;
+    }
+    
+    /*
+     *  int enter(int *s, int *display, struct vmregs *r, void *target)
+     * 汻߱Ĵrװtbκtarget
+     * غtbдreaxԭأ켣ڵַ
+     */
+    byte(0x53); byte(0x55);                              /* push rbx; push rbp */
+    byte(0x41); byte(0x54); byte(0x41); byte(0x55);      /* push r12; push r13 */
+    byte(0x41); byte(0x56); byte(0x41); byte(0x57);      /* push r14; push r15 */
+    byte(0x52);                                          /* push rdx */
+    byte(0x48); byte(0x89); byte(0xfb);                  /* mov rbx, rdi */
+    byte(0x49); byte(0x89); byte(0xf6);                  /* mov r14, rsi */
+    byte(0x4c); byte(0x63); byte(0x22);                  /* movsxd r12, [rdx] */
+    byte(0x4c); byte(0x63); byte(0x6a); byte(4);         /* movsxd r13, [rdx+4] */
+    byte(0x4c); byte(0x63); byte(0x7a); byte(8);         /* movsxd r15, [rdx+8] */
+    byte(0xff); byte(0xd1);                              /* call rcx */
+    byte(0x5a);                                          /* pop rdx */
+    byte(0x44); byte(0x89); byte(0x22);                  /* mov [rdx], r12d */
+    byte(0x44); byte(0x89); byte(0x6a); byte(4);         /* mov [rdx+4], r13d */
+    byte(0x44); byte(0x89); byte(0x7a); byte(8);         /* mov [rdx+8], r15d */
+    byte(0x41); byte(0x5f); byte(0x41); byte(0x5e);      /* pop r15; pop r14 */
+    byte(0x41); byte(0x5d); byte(0x41); byte(0x5c);      /* pop r13; pop r12 */
+    byte(0x5d); byte(0x5b);                              /* pop rbp; pop rbx */
+    byte(0xc3);
+    mprotect(buf, bufsize, PROT_READ | PROT_EXEC);
+    return 1;
+}
+
+/* ͷŴ뻺 */
+void jit_free() {
+    munmap(buf, bufsize);
+}
+
+/* code[from..to]ɵֽ */
+int jit_compile(int from, int to) {
+    int start, k, rel;
+    
+    start = bx = (bx + pagesize - 1) / pagesize * pagesize;
+    mprotect(buf + start, bufsize - start, PROT_READ | PROT_WRITE);
+    nfix = 0;
+    for (k = from; k <= to; k++) {
+        noff[k] = bx;    /* бǣڵĵݹÿֱcall */
+    }
+    for (k = from; k <= to; k++) {
+        noff[k] = bx;
+        compile(k);
+    }
+    for (k = 0; k < nfix; k++) {
+        rel = noff[fixtarget[k]] - (fixup[k] + 4);
+        memcpy(buf + fixup[k], &rel, 4);
+    }
+    mprotect(buf + start, bufsize - start, PROT_READ | PROT_EXEC);
+    return bx - start;
+}
+
+/* תƫ¼ķʱڣسڴcode[]ַ */
+static void guard(int jcc, int taken, int k, int *nexit) {
+    struct instruction *i = &code[k];
+    
+    if (taken) {
+        jcc ^= 1;    /* תδתʱ */
+    }
+    byte(jcc >> 8);
+    byte(jcc & 0xff);
+    exitat[*nexit] = bx;
+    exitpc[(*nexit)++] = taken ? k + 1 : i->a;
+    dword(0);
+}
+
+/* Ѽ¼Ĺ켣Ϊ룬ƫƣʱ-1 */
+int jit_trace(struct traceop *tr, int n, int lev) {
+    int start, j, k, rel, nexit;
+    int levs[TRACEMAX];    /* չĵиߵĲ */
+    int depth = 0;
+    struct instruction *i;
+    enum fct f;
+    
+    start = (bx + pagesize - 1) / pagesize * pagesize;
+    if (start + n * 80 + pagesize > bufsize) {
+        return -1;
+    }
+    bx = start;
+    mprotect(buf + start, bufsize - start, PROT_READ | PROT_WRITE);
+    nexit = 0;
+    
+    for (j = 0; j < n; j++) {
+        k = tr[j].k;
+        i = &code[k];
+        f = i->f;
+        switch (f) {
+            case STC: f = LIT; break;
+            case UPD: case JVV: case JVC: f = LOD; break;
+            default: break;
+        }
+        
+        switch (f) {
+            case JMP:
+                break;
+                
+            case JPC:
+                memop(0, 0x8b, RAX, ST(0));
+                lea12(-1);
+                byte(0x85); byte(0xc0);                      /* test eax, eax */
+                guard(0x0f84, tr[j].taken, k, &nexit);
+                break;
+                
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+                memop(0, 0x8b, RAX, ST(-1));
+                memop(0, 0x3b, RAX, ST(0));
+                lea12(-2);
+                guard(jfalse[f - JEQ], tr[j].taken, k, &nexit);
+                break;
+                
+            case JOD:
+                memop(0, 0x8b, RAX, ST(0));
+                lea12(-1);
+                byte(0xa9); dword(1);                        /* test eax, 1 */
+                guard(i->l ? 0x0f85 : 0x0f84, tr[j].taken, k, &nexit);
+                break;
+                
+            case CAL:
+                /* ¼ã켣¼ */
+                levs[depth++] = lev;
+                lev = lev - i->l + 1;
+                byte(0x49); byte(0xc7); byte(0xc7); dword(lev);  /* mov r15, lev */
+                memop(0, 0x8b, RAX, DISP(0));
+                memop(0, 0x89, RAX, ST(1));
+                memop(0, 0x89, R13, ST(2));
+                memop(0, 0xc7, 0, ST(3));
+                dword(k + 1);
+                byte(0x4d); byte(0x8d); byte(0x6c); byte(0x24); byte(0x01);  /* lea r13, [r12+1] */
+                memop(0, 0x89, R13, DISP(0));
+                break;
+                
+            case OPR:
+                if (i->a == 0) {
+                    byte(0x4d); byte(0x8d); byte(0x65); byte(0xff);  /* lea r12, [r13-1] */
+                    memop(0, 0x8b, RAX, SB(0));
+                    memop(0, 0x89, RAX, DISP(0));
+                    memop(1, 0x63, R13, SB(1));
+                    lev = levs[--depth];
+                    byte(0x49); byte(0xc7); byte(0xc7); dword(lev);  /* mov r15, lev */
+                } else {
+                    compile(k);
+                }
+                break;
+                
+            default:
+                compile(k);
+                break;
+        }
+    }
+    
+    /* صѭͷ */
+    byte(0xe9);
+    dword(start - (bx + 4));
+    
+    /* ڣmov eax, pc; ret */
+    for (j = 0; j < nexit; j++) {
+        rel = bx - (exitat[j] + 4);
+        memcpy(buf + exitat[j], &rel, 4);
+        byte(0xb8); dword(exitpc[j]);
+        byte(0xc3);
+    }
+    mprotect(buf + start, bufsize - start, PROT_READ | PROT_EXEC);
+    return start;
+}
+
+/* ִƫΪoffĹ켣سڴcode[]ַ */
+int jit_run_trace(int off, int *s, int *display, struct vmregs *r) {
+    int (*enter)(int *, int *, struct vmregs *, void *);
+    enter = (int (*)(int *, int *, struct vmregs *, void *))buf;
+    return enter(s, display, r, buf + off);
+}
+
+/* code[k]Ƿѱ */
+int jit_compiled(int k) {
+    return noff[k] >= 0;
+}
+
+/* code[k]룬ֱôڵĻ¼ */
+void jit_enter(int k, int *s, int *display, struct vmregs *r) {
+    void (*enter)(int *, int *, struct vmregs *, void *);
+    enter = (void (*)(int *, int *, struct vmregs *, void *))buf;
+    enter(s, display, r, buf + noff[k]);
+}
+
+/* ʱ벢ִ */
+void run_jit() {
+    int *s = vm_stack;
+    int display[LEVMAX + 1];
+    struct vmregs r;
+    int n;
+    
+    if (!jit_init(0)) {
+        printf("JIT: cannot allocate code buffer, interpreting\n");
+        run_switch();
+        return;
+    }
+    n = jit_compile(0, cx - 1);
+    if (vm_stats) {
+        printf("JIT: %d bytes of native code\n", n);
+    }
+    
+    r.t = 0;
+    r.b = 1;
+    r.lev = 0;
+    display[0] = 1;
+    jit_enter(0, s, display, &r);
+    vm_dispatch = 0;
+    jit_free();
+}
+
+#else
+
+/* x86-64ƽ̨˻ؽִ */
+int jit_init(int tier) {
+    return 0;
+}
+
+void jit_free() {
+}
+
+int jit_compile(int from, int to) {
+    return 0;
+}
+
+int jit_compiled(int k) {
+    return 0;
+}
+
+void jit_enter(int k, int *s, int *display, struct vmregs *r) {
+}
+
+int jit_trace(struct traceop *tr, int n, int lev) {
+    return -1;
+}
+
+int jit_run_trace(int off, int *s, int *display, struct vmregs *r) {
+    return 0;
+}
+
+void run_jit() {
+    printf("JIT not available on this platform, interpreting\n");
+    run_switch();
+}
+
+#endif
@@ -425,24 +425,10 @@ char *yytext;
 #include "pl0.h"
 #include "pl0.tab.h"
 
-int line_no = 1;
-int col_no = 1;
-
-void count() {
-    int i;
-    for (i = 0; yytext[i] != '\0'; i++) {
-        if (yytext[i] == '\n') {
-            col_no = 1;
-            line_no++;
-        } else if (yytext[i] == '\t') {
-            col_no += 8 - (col_no % 8);
-        } else {
-            col_no++;
-        }
-    }
-}
+/* 每个记号只累加其长度，行列号在报错时才由src_position()求出 */
+#define YY_USER_ACTION src_offset += yyleng;
 
-#line 446 "lex.yy.c"
+#line 432 "lex.yy.c"
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
@@ -593,10 +579,10 @@ YY_DECL
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
 
-#line 38 "pl0.l"
+#line 24 "pl0.l"
 
 
-#line 600 "lex.yy.c"
+#line 586 "lex.yy.c"
 
 	if ( yy_init )
 		{
@@ -681,199 +667,197 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 40 "pl0.l"
-{ count(); /* 忽略注释 */ }
+#line 26 "pl0.l"
+{ /* 忽略注释 */ }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 41 "pl0.l"
-{ count(); /* 忽略空白字符 */ }
+#line 27 "pl0.l"
+{ /* 忽略空白字符 */ }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 42 "pl0.l"
-{ count(); }
+#line 28 "pl0.l"
+{ }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 44 "pl0.l"
-{ count(); return CONST; }
+#line 30 "pl0.l"
+{ return CONST; }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 45 "pl0.l"
-{ count(); return VAR; }
+#line 31 "pl0.l"
+{ return VAR; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 46 "pl0.l"
-{ count(); return PROCEDURE; }
+#line 32 "pl0.l"
+{ return PROCEDURE; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 47 "pl0.l"
-{ count(); return CALL; }
+#line 33 "pl0.l"
+{ return CALL; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 48 "pl0.l"
-{ count(); return BEGIN_SYM; }
+#line 34 "pl0.l"
+{ return BEGIN_SYM; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 49 "pl0.l"
-{ count(); return END; }
+#line 35 "pl0.l"
+{ return END; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 50 "pl0.l"
-{ count(); return IF; }
+#line 36 "pl0.l"
+{ return IF; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 51 "pl0.l"
-{ count(); return THEN; }
+#line 37 "pl0.l"
+{ return THEN; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 52 "pl0.l"
-{ count(); return WHILE; }
+#line 38 "pl0.l"
+{ return WHILE; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 53 "pl0.l"
-{ count(); return DO; }
+#line 39 "pl0.l"
+{ return DO; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 54 "pl0.l"
-{ count(); return ODD; }
+#line 40 "pl0.l"
+{ return ODD; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 55 "pl0.l"
-{ count(); return READ; }
+#line 41 "pl0.l"
+{ return READ; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 56 "pl0.l"
-{ count(); return WRITE; }
+#line 42 "pl0.l"
+{ return WRITE; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 58 "pl0.l"
-{ count(); return ASSIGN; }
+#line 44 "pl0.l"
+{ return ASSIGN; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 59 "pl0.l"
-{ count(); return EQ; }
+#line 45 "pl0.l"
+{ return EQ; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 60 "pl0.l"
-{ count(); return NE; }
+#line 46 "pl0.l"
+{ return NE; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 61 "pl0.l"
-{ count(); return LT; }
+#line 47 "pl0.l"
+{ return LT; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 62 "pl0.l"
-{ count(); return LE; }
+#line 48 "pl0.l"
+{ return LE; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 63 "pl0.l"
-{ count(); return GT; }
+#line 49 "pl0.l"
+{ return GT; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 64 "pl0.l"
-{ count(); return GE; }
+#line 50 "pl0.l"
+{ return GE; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 65 "pl0.l"
-{ count(); return PLUS; }
+#line 51 "pl0.l"
+{ return PLUS; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 66 "pl0.l"
-{ count(); return MINUS; }
+#line 52 "pl0.l"
+{ return MINUS; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 67 "pl0.l"
-{ count(); return TIMES; }
+#line 53 "pl0.l"
+{ return TIMES; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 68 "pl0.l"
-{ count(); return SLASH; }
+#line 54 "pl0.l"
+{ return SLASH; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 69 "pl0.l"
-{ count(); return LPAREN; }
+#line 55 "pl0.l"
+{ return LPAREN; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 70 "pl0.l"
-{ count(); return RPAREN; }
+#line 56 "pl0.l"
+{ return RPAREN; }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 71 "pl0.l"
-{ count(); return COMMA; }
+#line 57 "pl0.l"
+{ return COMMA; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 72 "pl0.l"
-{ count(); return SEMICOLON; }
+#line 58 "pl0.l"
+{ return SEMICOLON; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 73 "pl0.l"
-{ count(); return PERIOD; }
+#line 59 "pl0.l"
+{ return PERIOD; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 75 "pl0.l"
+#line 61 "pl0.l"
 { 
-                    count(); 
-                    yylval.ident = (char*)malloc(strlen(yytext) + 1);
-                    strcpy(yylval.ident, yytext);
+                    yylval.ident = intern(yytext, yyleng);
                     return IDENT; 
                 }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 82 "pl0.l"
+#line 66 "pl0.l"
 { 
-                    count(); 
                     yylval.number = atoi(yytext);
                     return NUMBER; 
                 }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 88 "pl0.l"
+#line 71 "pl0.l"
 { 
-                    count();
+                    int line, col;
+                    src_position(src_offset, &line, &col);
                     printf("Error: Unexpected character '%s' at line %d, column %d\n", 
-                           yytext, line_no, col_no);
+                           yytext, line, col);
                     return yytext[0];
                 }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 95 "pl0.l"
+#line 79 "pl0.l"
 ECHO;
 	YY_BREAK
-#line 877 "lex.yy.c"
+#line 861 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1759,4 +1743,24 @@ int main()
 	return 0;
 	}
 #endif
-#line 95 "pl0.l"
+#line 79 "pl0.l"
+
+/* 打开源文件，失败返回0 */
+int src_open(const char *name) {
+    yyin = fopen(name, "r");
+    return yyin != NULL;
+}
+
+/* 扫描内存中的源程序p[0..n)，flex会复制一份 */
+void src_buffer(const char *p, long n) {
+    yy_scan_bytes(p, n);
+    src_text(p, n);
+}
+
+/* 编译结束后关闭源文件 */
+void src_close() {
+    if (yyin) {
+        fclose(yyin);
+        yyin = NULL;
+    }
+}
@@ -0,0 +1,518 @@
+/* licm.c - PL/0 ѭ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * WHILEתѭɽǰJMPʱ
+ * ѭ塣ÿ̵Ŀͼ֧u->hh֧uʱǻرߣ
+ * uǰҵhΪֹõȻѭͬһ׿ĻرߺΪһѭ
+ * ׿ѭǰֻһJMP׿βʱڸJMP֮ǰǰ
+ * 룻״ѭ
+ * ѭǿLITLODOPRУȡı
+ * ѭûSTOѭCALĹҲдֻ0-1
+ * ⳣģѭһҲִʱǰôгÿֻΪ
+ * ڲѭ᣻ͬһѭͬйһʱʱ
+ * ڹ̵ĩβINT֮ѭٴ
+ * ǰô룬ظٱ仯
+ */
+
+#define LOOPMAX   (1 << 24)  /* ÿѭԱܹģ */
+#define ROUNDMAX  16         /*  */
+
+int licm_hoisted;            /*  */
+int licm_loops;              /* ѭ */
+
+/* ջϵֵpureʱ[start, end]ǡǼָ */
+struct lslot {
+    int start, end;
+    int pure;
+    int inv;                 /* ѭ */
+    int ops;                 /* е */
+};
+
+/* ĺѡ */
+struct cand {
+    int loop;
+    int start, end;
+    int tmp;                 /* ʱĵַ */
+};
+
+static int nb, nv;
+static int *predstart, *preds;   /* ǰpreds[predstart[b]..predstart[b+1]) */
+static int *idom, *postnum;      /* ֧ */
+static int *inner;               /* ڲѭ-1ʾѭ */
+
+/* ѭ */
+static struct loop {
+    int head;                /* ׿ */
+    int size;                /*  */
+    int at;                  /* ǰôڴָ֮ǰ-1ʾ */
+    char *stored;            /* ѭǷܱд */
+} *loops;
+static int nloops;
+
+static struct lslot stk[CXMAX];
+static int sp;
+static struct cand *cands;
+static int ncands, candsize;
+
+/* ǰ */
+static void findpreds() {
+    int b, e, s;
+    
+    for (b = 0; b <= nb; b++) {
+        predstart[b] = 0;
+    }
+    for (b = 0; b < nb; b++) {
+        for (e = 0; e < 2; e++) {
+            if ((s = blocks[b].succ[e]) >= 0) {
+                predstart[s + 1]++;
+            }
+        }
+    }
+    for (b = 0; b < nb; b++) {
+        predstart[b + 1] += predstart[b];
+    }
+    for (b = 0; b < nb; b++) {
+        for (e = 0; e < 2; e++) {
+            if ((s = blocks[b].succ[e]) >= 0) {
+                preds[predstart[s]++] = b;
+            }
+        }
+    }
+    for (b = nb; b > 0; b--) {
+        predstart[b] = predstart[b - 1];
+    }
+    predstart[0] = 0;
+}
+
+/* ţorder[]УؿɴĿ */
+static int postorder(int *order) {
+    int *st, *next, n = 0, top = 0, b, s;
+    
+    st = malloc(nb * sizeof(int));
+    next = calloc(nb, sizeof(int));
+    if (!st || !next) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (b = 0; b < nb; b++) {
+        postnum[b] = -2;    /* δ */
+    }
+    postnum[0] = -1;
+    st[top++] = 0;
+    while (top > 0) {
+        b = st[top - 1];
+        if (next[b] < 2) {
+            s = blocks[b].succ[next[b]++];
+            if (s >= 0 && postnum[s] == -2) {
+                postnum[s] = -1;
+                st[top++] = s;
+            }
+        } else {
+            postnum[b] = n;
+            order[n++] = b;
+            top--;
+        }
+    }
+    free(st);
+    free(next);
+    return n;
+}
+
+/* ֧ab */
+static int intersect(int a, int b) {
+    while (a != b) {
+        while (postnum[a] < postnum[b]) {
+            a = idom[a];
+        }
+        while (postnum[b] < postnum[a]) {
+            b = idom[b];
+        }
+    }
+    return a;
+}
+
+/* ֧CooperHarveyKennedyĵ㷨 */
+static void dominators() {
+    int *order, n, j, k, b, d, changed;
+    
+    order = malloc(nb * sizeof(int));
+    if (!order) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    n = postorder(order);
+    for (b = 0; b < nb; b++) {
+        idom[b] = -1;
+    }
+    idom[0] = 0;
+    do {
+        changed = 0;
+        for (j = n - 2; j >= 0; j--) {    /* ڿ */
+            b = order[j];
+            d = -1;
+            for (k = predstart[b]; k < predstart[b + 1]; k++) {
+                if (idom[preds[k]] >= 0) {
+                    d = d < 0 ? preds[k] : intersect(preds[k], d);
+                }
+            }
+            if (d != idom[b]) {
+                idom[b] = d;
+                changed = 1;
+            }
+        }
+    } while (changed);
+    free(order);
+}
+
+/* aǷ֧b */
+static int dominates(int a, int b) {
+    while (b != a && b != 0) {
+        b = idom[b];
+    }
+    return b == a;
+}
+
+/* code[start..end]Ϊѭlĺѡ */
+static void addcand(int l, int start, int end) {
+    if (ncands == candsize) {
+        candsize = candsize ? candsize * 2 : 64;
+        cands = realloc(cands, candsize * sizeof(struct cand));
+        if (!cands) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+    }
+    cands[ncands].loop = l;
+    cands[ncands].start = start;
+    cands[ncands].end = end;
+    ncands++;
+}
+
+/* ҳpȻѭǰôλдıѭ */
+static int findloops(struct proc *p) {
+    int *work, *mark, *memb, nw, nm, h, u, e, j, k, b;
+    struct loop *lp;
+    
+    work = malloc(nb * sizeof(int));
+    mark = malloc(nb * sizeof(int));
+    memb = malloc(nb * sizeof(int));
+    if (!work || !mark || !memb) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (b = 0; b < nb; b++) {
+        inner[b] = -1;
+        mark[b] = -1;
+    }
+    nloops = 0;
+    for (h = 0; h < nb; h++) {
+        /* ׿ΪhĻرߵԴǰҳѭ */
+        nw = nm = e = 0;
+        mark[h] = h;
+        memb[nm++] = h;
+        for (k = predstart[h]; k < predstart[h + 1]; k++) {
+            u = preds[k];
+            /* رָ߱ȵı */
+            if (idom[u] >= 0 && postnum[h] >= postnum[u] && dominates(h, u)) {
+                if (mark[u] != h) {
+                    mark[u] = h;
+                    memb[nm++] = work[nw++] = u;
+                }
+                e = 1;
+            }
+        }
+        if (nm == 1 && !e) {
+            continue;
+        }
+        while (nw > 0) {
+            u = work[--nw];
+            for (k = predstart[u]; k < predstart[u + 1]; k++) {
+                if (idom[preds[k]] >= 0 && mark[preds[k]] != h) {
+                    mark[preds[k]] = h;
+                    memb[nm++] = work[nw++] = preds[k];
+                }
+            }
+        }
+        lp = &loops[nloops];
+        lp->head = h;
+        lp->size = nm;
+        /* ǰôλãѭΨһǰJMP hβ */
+        lp->at = -1;
+        e = -1;
+        for (k = predstart[h]; k < predstart[h + 1]; k++) {
+            if (idom[preds[k]] >= 0 && mark[preds[k]] != h) {
+                e = e == -1 ? preds[k] : -2;
+            }
+        }
+        if (e >= 0 && code[blocks[e].end - 1].f == JMP) {
+            lp->at = blocks[e].end - 1;
+        }
+        /* ѭڸдı¸ڵڲѭ */
+        lp->stored = calloc(nv + 1, 1);
+        if (!lp->stored) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+        for (j = 0; j < nm; j++) {
+            b = memb[j];
+            if (inner[b] < 0 || loops[inner[b]].size > lp->size) {
+                inner[b] = nloops;
+            }
+            for (k = blocks[b].start; k < blocks[b].end; k++) {
+                if (code[k].f == STO || code[k].f == STK) {
+                    lp->stored[varno(varof(p, k))] = 1;
+                } else if (code[k].f == CAL) {
+                    for (e = 0; e < nv; e++) {
+                        if (inset(&procs[procat[code[k].a]].mods, varids[e])) {
+                            lp->stored[e] = 1;
+                        }
+                    }
+                }
+            }
+        }
+        nloops++;
+    }
+    free(work);
+    free(mark);
+    free(memb);
+    return nloops;
+}
+
+static void push(int k, int inv) {
+    stk[sp].start = stk[sp].end = k;
+    stk[sp].pure = 1;
+    stk[sp].inv = inv;
+    stk[sp].ops = 0;
+    sp++;
+}
+
+/* ջnֵָܷkϲΪһ */
+static int joinable(int n, int k) {
+    int j;
+    
+    for (j = sp - n; j < sp; j++) {
+        if (!stk[j].pure || !stk[j].inv || stk[j].end + 1 != (j + 1 < sp ? stk[j + 1].start : k)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* nֵָеĲΪѭlĺѡ */
+static void consume(int n, int l) {
+    struct lslot *s;
+    
+    for (; n > 0 && sp > 0; n--) {
+        s = &stk[--sp];
+        if (s->pure && s->inv && s->ops > 0) {
+            addcand(l, s->start, s->end);
+        }
+    }
+}
+
+/* ڿbѭlĺѡ */
+static void scanblock(struct proc *p, int b, int l) {
+    struct instruction *i;
+    char *stored = loops[l].stored;
+    int k, n, a;
+    
+    sp = 0;
+    for (k = blocks[b].start; k < blocks[b].end; k++) {
+        i = &code[k];
+        switch (i->f) {
+            case LIT:
+                push(k, 1);
+                break;
+            case LOD:
+                push(k, !stored[varno(varof(p, k))]);
+                break;
+            case OPR:
+                a = i->a;
+                n = (a == 1 || a == 6) ? 1 : 2;
+                if (a == 0 || a == 15) {
+                    break;
+                } else if (a == 14) {
+                    consume(1, l);
+                } else if (a == 16) {
+                    push(k, 0);
+                } else if (sp >= n && ((a >= 1 && a <= 4) || a == 6 || (a >= 8 && a <= 13)
+                           || (a == 5 && stk[sp - 1].end == stk[sp - 1].start
+                               && code[stk[sp - 1].end].f == LIT && code[stk[sp - 1].end].a != 0
+                               && code[stk[sp - 1].end].a != -1))
+                           && joinable(n, k)) {
+                    sp -= n - 1;
+                    stk[sp - 1].end = k;
+                    stk[sp - 1].ops++;
+                    if (n == 2) {
+                        stk[sp - 1].ops += stk[sp].ops;
+                    }
+                } else {
+                    consume(n, l);
+                    push(k, 0);
+                }
+                break;
+            case STO:
+                consume(1, l);
+                break;
+            case INT:
+                if (i->a < 0) {
+                    consume(-i->a, l);
+                }
+                break;
+            case JPC:
+            case JOD:
+                consume(1, l);
+                break;
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+                consume(2, l);
+                break;
+            case CAL:
+            case JMP:
+                break;
+            default:
+                /* STK볬ָջϵֵ */
+                for (n = 0; n < sp; n++) {
+                    stk[n].pure = 0;
+                }
+                break;
+        }
+    }
+}
+
+/* code[x..]code[y..]ǰnָǷͬ */
+static int samecode(int x, int y, int n) {
+    int j;
+    
+    for (j = 0; j < n; j++) {
+        if (code[x + j].f != code[y + j].f || code[x + j].l != code[y + j].l
+            || code[x + j].a != code[y + j].a) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* pеĺѡ */
+static int hoist(struct proc *p) {
+    static struct instruction seq[CXMAX];
+    struct cand *c, *d;
+    int k, n = 0, len;
+    char *done;
+    
+    done = calloc(nloops + 1, 1);
+    if (!done) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (c = cands; c < cands + ncands; c++) {
+        len = c->end - c->start + 1;
+        c->tmp = -1;
+        /* ͬһѭͬ */
+        for (d = cands; d < c; d++) {
+            if (d->loop == c->loop && d->tmp >= 0 && d->end - d->start + 1 == len
+                && samecode(d->start, c->start, len)) {
+                c->tmp = d->tmp;
+                break;
+            }
+        }
+        if (c->tmp < 0) {
+            memcpy(seq, &code[c->start], len * sizeof(struct instruction));
+            seq[len].f = STO;
+            seq[len].l = 0;
+            seq[len].a = code[p->entry].a;
+            if (!insertcode(loops[c->loop].at, seq, len + 1)) {
+                continue;
+            }
+            c->tmp = code[p->entry].a++;
+            n++;
+            if (!done[c->loop]) {
+                done[c->loop] = 1;
+                licm_loops++;
+            }
+        }
+    }
+    /* ȫȽٰѭڵиΪȡʱ */
+    for (c = cands; c < cands + ncands; c++) {
+        if (c->tmp < 0) {
+            continue;
+        }
+        for (k = c->start; k < c->end; k++) {
+            discard(k);
+        }
+        code[c->end].f = LOD;
+        code[c->end].l = 0;
+        code[c->end].a = c->tmp;
+    }
+    free(done);
+    return n;
+}
+
+/* Թpһᣬ */
+static int licmproc(struct proc *p) {
+    int b, l, n = 0;
+    
+    nb = buildblocks(p);
+    nv = numbervars(p);
+    if (nb < 0 || nv < 0 || (long long)nb * (nv + 16) > LOOPMAX) {
+        return 0;
+    }
+    predstart = malloc((nb + 1) * sizeof(int));
+    preds = malloc(2 * nb * sizeof(int) + 1);
+    idom = malloc(nb * sizeof(int));
+    postnum = malloc(nb * sizeof(int));
+    inner = malloc(nb * sizeof(int));
+    loops = malloc(nb * sizeof(struct loop));
+    if (!predstart || !preds || !idom || !postnum || !inner || !loops) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    findpreds();
+    dominators();
+    findloops(p);
+    ncands = 0;
+    for (b = 0; b < nb; b++) {
+        l = inner[b];
+        if (l >= 0 && loops[l].at >= 0) {
+            scanblock(p, b, l);
+        }
+    }
+    if (ncands > 0) {
+        n = hoist(p);
+    }
+    for (l = 0; l < nloops; l++) {
+        free(loops[l].stored);
+    }
+    free(predstart);
+    free(preds);
+    free(idom);
+    free(postnum);
+    free(inner);
+    free(loops);
+    return n;
+}
+
+/* ѭᣬ */
+int licm() {
+    int j, n, round, total = 0;
+    
+    licm_loops = 0;
+    for (round = 0; round < ROUNDMAX; round++) {
+        findprocs();
+        n = 0;
+        for (j = 0; j < nprocs; j++) {
+            n += licmproc(&procs[j]);
+        }
+        compact();
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    licm_hoisted = total;
+    return total;
+}
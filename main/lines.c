@@ -0,0 +1,136 @@
+/* lines.c - PL/0 Դк */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pl0.h"
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * ʷֻ¼һǺֽ֮ƫsrc_offsetк
+ * ڱʱsrc_position()Ϊ˰轨з
+ * nl[k]Ϊk + 1зƫƣֻɨ赽ѯƫΪֹ
+ * ɨʱSSE2һαȽ16ֽڡкɶֲҵõкŴ
+ * ַ㣬ƱĹԭcount()ͬ
+ * Դڴʱsrc_text()ǼǣһβѯʱyyinӦ
+ * ļ롣
+ */
+
+long src_offset;             /* һǺֽ֮ƫ */
+
+extern FILE *yyin;
+
+static const char *text;     /* Դ */
+static long textlen;
+static char *owned;          /* жԴ */
+static long *nl;             /* зƫ */
+static int nnl, nlsize;
+static long scanned;         /* ѽֽ */
+
+/* ǼڴеԴp[0..n) */
+void src_text(const char *p, long n) {
+    text = p;
+    textlen = n;
+    nnl = 0;
+    scanned = 0;
+}
+
+/* yyinӦļԴ򣬲ӰʷĶȡλ */
+static void readsource() {
+    long size = 65536, n = 0, k;
+    
+    owned = malloc(size);
+#if defined(__unix__)
+    while (owned && yyin && (k = pread(fileno(yyin), owned + n, size - n, n)) > 0) {
+        n += k;
+        if (n == size) {
+            size *= 2;
+            owned = realloc(owned, size);
+        }
+    }
+#endif
+    if (!owned) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    src_text(owned, n);
+}
+
+static void addnl(long off) {
+    if (nnl == nlsize) {
+        nlsize = nlsize ? nlsize * 2 : 1024;
+        nl = realloc(nl, nlsize * sizeof(long));
+        if (!nl) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+    }
+    nl[nnl++] = off;
+}
+
+/* ѻзƫtoΪֹ */
+static void buildindex(long to) {
+    long k = scanned;
+    
+    if (to > textlen) {
+        to = textlen;
+    }
+#if defined(__SSE2__)
+    {
+        __m128i lf = _mm_set1_epi8('\n');
+        for (; k + 16 <= to; k += 16) {
+            unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128((const __m128i *)(text + k)), lf));
+            while (m != 0) {
+                addnl(k + __builtin_ctz(m));
+                m &= m - 1;
+            }
+        }
+    }
+#endif
+    for (; k < to; k++) {
+        if (text[k] == '\n') {
+            addnl(k);
+        }
+    }
+    if (k > scanned) {
+        scanned = k;
+    }
+}
+
+/* ƫoffккţoff֮ǰַѼ */
+void src_position(long off, int *line, int *col) {
+    int lo = 0, hi, c = 1;
+    long k, start;
+    
+    if (text == NULL) {
+        readsource();
+    }
+    buildindex(off);
+    
+    /* ƫСoffĻз */
+    hi = nnl;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (nl[mid] < off) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    start = lo > 0 ? nl[lo - 1] + 1 : 0;
+    for (k = start; k < off && k < textlen; k++) {
+        if (text[k] == '\t') {
+            c += 8 - (c % 8);
+        } else {
+            c++;
+        }
+    }
+    *line = lo + 1;
+    *col = c;
+}
@@ -0,0 +1,597 @@
+/* opt.c - PL/0 ĿŻ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl0.h"
+
+/* Ż */
+int opt_fold = 0;     /* ۵ */
+int opt_peephole = 0; /* Ż */
+int opt_super = 0;    /* ָ */
+int opt_sccp = 0;     /*  */
+int opt_dce = 0;      /* ɾ */
+int opt_licm = 0;     /* ѭ */
+int opt_strength = 0; /* ǿ */
+
+/* ŻرӦе-f<>-fno-<> */
+struct optflag {
+    char *name;
+    int *flag;
+};
+
+static struct optflag optflags[] = {
+    {"fold", &opt_fold},
+    {"sccp", &opt_sccp},
+    {"dce", &opt_dce},
+    {"licm", &opt_licm},
+    {"strength", &opt_strength},
+    {"peephole", &opt_peephole},
+    {"super", &opt_super}
+};
+
+#define NOPTFLAGS (int)(sizeof(optflags) / sizeof(optflags[0]))
+
+/* ŻأЧʱ0 */
+int setopt(char *arg) {
+    int k, on = 1;
+    if (strncmp(arg, "no-", 3) == 0) {
+        on = 0;
+        arg += 3;
+    }
+    for (k = 0; k < NOPTFLAGS; k++) {
+        if (strcmp(arg, optflags[k].name) == 0) {
+            *optflags[k].flag = on;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ȫŻ */
+void setallopt() {
+    int k;
+    for (k = 0; k < NOPTFLAGS; k++) {
+        *optflags[k].flag = 1;
+    }
+}
+
+/* fǷΪתָ */
+int isjump(enum fct f) {
+    return f == JMP || f == JPC || (f >= JEQ && f <= JOD);
+}
+
+/* תõĿַ */
+static void marktargets(char target[]) {
+    int k;
+    memset(target, 0, cx);
+    for (k = 0; k < cx; k++) {
+        if (isjump(code[k].f) || code[k].f == CAL) {
+            target[code[k].a] = 1;
+        }
+    }
+}
+
+/* code[k]ǷΪָf */
+static int isop(int k, enum fct f) {
+    return k < cx && code[k].f == f;
+}
+
+/* code[k]ǷΪӲlo~hi֮OPR */
+static int isopr(int k, int lo, int hi) {
+    return k < cx && code[k].f == OPR && code[k].a >= lo && code[k].a <= hi;
+}
+
+/* code[k]ǷΪJEQ~JLE */
+static int isrel(int k) {
+    return k < cx && code[k].f >= JEQ && code[k].f <= JLE;
+}
+
+/*
+ * ŻÿָĹģʽһдÿһ
+ * ǰÿλγԸ򣬹ָδɾȥ
+ * ⶼתĿʱøдʱ
+ * ͵ظдcode[]ɾȥָdead[]бǣ1һѹ
+ * code[]ضλȫתĿtable[]еĹڣɾȥָ
+ * ӳ䵽һָظֱĳһûид
+ * code[0]ڵJMPʼձصַ0ʾ
+ */
+
+#define P_JUMP  -1    /* ģʽһתָ */
+#define P_COND  -2    /* ģʽתָ */
+#define P_PUSH  -3    /* ģʽLITLOD */
+
+struct prule {
+    char *name;
+    int len;                 /* ģʽָ */
+    int f[3];                /* ģʽ */
+    int (*rewrite)(int k);   /* дcode[k]Уɹ1 */
+    int count;               /* αдĴ */
+};
+
+static char dead[CXMAX];     /* ɾȥָ */
+
+/* LIT c; OPR 1  =>  LIT -c */
+static int neglit(int k) {
+    if (code[k + 1].a != 1) {
+        return 0;
+    }
+    code[k].a = -code[k].a;
+    dead[k + 1] = 1;
+    return 1;
+}
+
+/* OPR 1; OPR 1  =>  ޣ */
+static int negneg(int k) {
+    if (code[k].a != 1 || code[k + 1].a != 1) {
+        return 0;
+    }
+    dead[k] = dead[k + 1] = 1;
+    return 1;
+}
+
+/* STO x; LOD x  =>  STK x */
+static int stoload(int k) {
+    if (code[k].l != code[k + 1].l || code[k].a != code[k + 1].a) {
+        return 0;
+    }
+    code[k].f = STK;
+    dead[k + 1] = 1;
+    return 1;
+}
+
+/* תJMPʱֱĿ */
+static int thread(int k) {
+    int a = code[k].a, n;
+    
+    for (n = 0; code[a].f == JMP && code[a].a != a && n < cx; n++) {
+        a = code[a].a;
+    }
+    if (a == code[k].a || a == k) {
+        return 0;
+    }
+    code[k].a = a;
+    return 1;
+}
+
+/* JMPһָ  =>  ޣ */
+static int jumpnext(int k) {
+    if (k == 0 || code[k].a != k + 1) {
+        return 0;
+    }
+    dead[k] = 1;
+    return 1;
+}
+
+/* תһָ  =>  INT */
+static int condnext(int k) {
+    if (code[k].a != k + 1) {
+        return 0;
+    }
+    code[k].a = (code[k].f >= JEQ && code[k].f <= JLE) ? -2 : -1;
+    code[k].f = INT;
+    code[k].l = 0;
+    return 1;
+}
+
+/* LIT/LOD; INT -n  =>  INT -(n-1)nΪ1ʱɾȥ */
+static int pushpop(int k) {
+    if (code[k + 1].a >= 0) {
+        return 0;    /* ڷռINT */
+    }
+    dead[k] = 1;
+    if (++code[k + 1].a == 0) {
+        dead[k + 1] = 1;
+    }
+    return 1;
+}
+
+static struct prule prules[] = {
+    {"neglit",   2, {LIT, OPR},    neglit},
+    {"negneg",   2, {OPR, OPR},    negneg},
+    {"stoload",  2, {STO, LOD},    stoload},
+    {"thread",   1, {P_JUMP},      thread},
+    {"jumpnext", 1, {JMP},         jumpnext},
+    {"condnext", 1, {P_COND},      condnext},
+    {"pushpop",  2, {P_PUSH, INT}, pushpop}
+};
+
+#define NPRULES (int)(sizeof(prules) / sizeof(prules[0]))
+
+/* fǷģʽp */
+static int matchf(int p, enum fct f) {
+    switch (p) {
+        case P_JUMP: return isjump(f);
+        case P_COND: return isjump(f) && f != JMP;
+        case P_PUSH: return f == LIT || f == LOD;
+        default:     return f == (enum fct)p;
+    }
+}
+
+/* rܷcode[k] */
+static int matchrule(struct prule *r, int k, char target[]) {
+    int j;
+    
+    if (k + r->len > cx) {
+        return 0;
+    }
+    for (j = 0; j < r->len; j++) {
+        if (dead[k + j] || !matchf(r->f[j], code[k + j].f) || (j > 0 && target[k + j])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ɾȥcode[k]compact()ͳһɾȥ */
+void discard(int k) {
+    dead[k] = 1;
+}
+
+/* 뵽code[at]֮ǰָseqͬһλõĲ˳ */
+struct pending {
+    int at, seq;
+    struct instruction i;
+};
+
+static struct pending pend[CXMAX];
+static int npend;
+
+/*
+ * code[k]֮ǰseq[0..n)compact()ͳһ롣ԭcode[k]
+ * תΪĵһָתҲԭַcode[]Ų
+ * ʱ룬0
+ */
+int insertcode(int k, struct instruction *seq, int n) {
+    int j;
+    
+    if (cx + npend + n > CXMAX) {
+        return 0;
+    }
+    for (j = 0; j < n; j++) {
+        pend[npend].at = k;
+        pend[npend].seq = npend;
+        pend[npend].i = seq[j];
+        npend++;
+    }
+    return 1;
+}
+
+static int cmppend(const void *x, const void *y) {
+    const struct pending *p = x, *q = y;
+    return p->at != q->at ? p->at - q->at : p->seq - q->seq;
+}
+
+/* ɾȥdead[]ǵָָضλؼٵ */
+int compact() {
+    static int newaddr[CXMAX + 1];
+    static struct instruction out[CXMAX];
+    int k, j = 0, n = 0;
+    
+    qsort(pend, npend, sizeof(struct pending), cmppend);
+    for (k = 0; k <= cx; k++) {
+        newaddr[k] = n;
+        for (; j < npend && pend[j].at == k; j++) {
+            out[n++] = pend[j].i;
+        }
+        if (k < cx && !dead[k]) {
+            out[n++] = code[k];
+        }
+    }
+    memcpy(code, out, n * sizeof(struct instruction));
+    for (k = 0; k < n; k++) {
+        if (isjump(code[k].f) || code[k].f == CAL) {
+            code[k].a = newaddr[code[k].a];
+        }
+    }
+    for (k = 1; k <= tx; k++) {
+        if (table[k].kind == PROCEDURE_SYM) {
+            table[k].adr = newaddr[table[k].adr];
+        }
+    }
+    memset(dead, 0, cx);
+    npend = 0;
+    k = cx - n;
+    cx = n;
+    return k;
+}
+
+/* Ӧùrules[0..n)ֱٸдɾȥָ */
+static int runrules(struct prule *rules, int n) {
+    static char target[CXMAX];
+    int k, j, changed, removed = 0;
+    
+    for (j = 0; j < n; j++) {
+        rules[j].count = 0;
+    }
+    memset(dead, 0, cx);
+    do {
+        changed = 0;
+        marktargets(target);
+        for (k = 0; k < cx; k++) {
+            for (j = 0; j < n && !dead[k]; j++) {
+                if (matchrule(&rules[j], k, target) && rules[j].rewrite(k)) {
+                    rules[j].count++;
+                    changed = 1;
+                }
+            }
+        }
+        removed += compact();
+    } while (changed);
+    return removed;
+}
+
+/* иĸд */
+static void printrules(struct prule *rules, int n) {
+    int j;
+    
+    for (j = 0; j < n; j++) {
+        if (rules[j].count > 0) {
+            printf(", %s %d", rules[j].name, rules[j].count);
+        }
+    }
+    printf("\n");
+}
+
+/* Żɾȥָ */
+int peephole() {
+    return runrules(prules, NPRULES);
+}
+
+/*
+ * ǿ򣬹Żһ׿ܡLIT c; OPRԳc
+ * ΪҲ㣺x+0x-0x*1x/1ɾȥx*-1Ϊȡ˳2
+ * ΪSHLSHRΪDVM32λ˷ȡλ
+ * ߵļӷ˷ȽԭOPRλͬ
+ * ʱҲһΪ0-1ʱгд
+ * ںΪUPDLOD;LIT;OPR;STOڴ򿪳ָʱдںϺ졣
+ * ODDȡڸִλԡ
+ */
+
+/* cΪ2kݣk >= 1ʱk򷵻0 */
+static int log2of(int c) {
+    int k;
+    
+    if (c < 2 || (c & (c - 1)) != 0) {
+        return 0;
+    }
+    for (k = 0; (1 << k) != c; k++)
+        ;
+    return k;
+}
+
+/* dd >= 3ħλHacker's Delight 10-1 */
+static void magic(int d, int *m, int *s) {
+    unsigned two31 = 0x80000000u, anc, q1, r1, q2, r2, delta;
+    int p = 31;
+    
+    anc = two31 - 1 - two31 % d;
+    q1 = two31 / anc;
+    r1 = two31 - q1 * anc;
+    q2 = two31 / d;
+    r2 = two31 - q2 * d;
+    do {
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            q1++;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= (unsigned)d) {
+            q2++;
+            r2 -= d;
+        }
+        delta = d - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    *m = (int)(q2 + 1);
+    *s = p - 32;
+}
+
+/* code[k]LIT;OPRǷΪsuperinstr()ںϵUPDһ */
+static int fusable(int k) {
+    return opt_super && k > 0 && code[k - 1].f == LOD && !dead[k - 1] && isop(k + 2, STO);
+}
+
+/* x; LIT 0; OPR 4  =>  LIT 0xΪLITLOD */
+static int zeroprod(int k) {
+    if (code[k + 1].a != 0 || code[k + 2].a != 4) {
+        return 0;
+    }
+    code[k].f = LIT;
+    code[k].l = 0;
+    code[k].a = 0;
+    dead[k + 1] = dead[k + 2] = 1;
+    return 1;
+}
+
+/* LOD x; LOD x; OPR 3  =>  LIT 0OPR 2  =>  LOD x; SHL 1 */
+static int selfop(int k) {
+    if (code[k].l != code[k + 1].l || code[k].a != code[k + 1].a
+        || (code[k + 2].a != 2 && code[k + 2].a != 3)) {
+        return 0;
+    }
+    if (code[k + 2].a == 3) {
+        code[k].f = LIT;
+        code[k].l = 0;
+        code[k].a = 0;
+        dead[k + 1] = 1;
+    } else {
+        code[k + 1].f = SHL;
+        code[k + 1].l = 0;
+        code[k + 1].a = 1;
+    }
+    dead[k + 2] = 1;
+    return 1;
+}
+
+/* LIT c; x; OPR 2|4  =>  x; LIT c; OPR 2|40 * x  =>  00 - x  =>  x; OPR 1 */
+static int constleft(int k) {
+    struct instruction i = code[k];
+    int c = code[k].a, a = code[k + 2].a;
+    
+    if (c == 0 && a == 4) {
+        dead[k + 1] = dead[k + 2] = 1;
+        return 1;
+    }
+    if (c == 0 && a == 3) {
+        code[k] = code[k + 1];
+        code[k + 1].f = OPR;
+        code[k + 1].l = 0;
+        code[k + 1].a = 1;
+        dead[k + 2] = 1;
+        return 1;
+    }
+    if (!(a == 2 && c == 0) && !(a == 4 && (c == 1 || c == -1 || log2of(c) > 0))) {
+        return 0;
+    }
+    code[k] = code[k + 1];
+    code[k + 1] = i;
+    return 1;
+}
+
+/* x+0x-0x*1x/1  =>  xx*-1  =>  x; OPR 1 */
+static int identity(int k) {
+    int c = code[k].a, a = code[k + 1].a;
+    
+    if (((a == 2 || a == 3) && c == 0) || ((a == 4 || a == 5) && c == 1)) {
+        dead[k] = dead[k + 1] = 1;
+        return 1;
+    }
+    if (a == 4 && c == -1) {
+        dead[k] = 1;
+        code[k + 1].a = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/* LIT 2^n; OPR 4|5  =>  SHL nSHR n */
+static int shift(int k) {
+    int n = log2of(code[k].a);
+    
+    if (n == 0 || (code[k + 1].a != 4 && code[k + 1].a != 5) || fusable(k)) {
+        return 0;
+    }
+    code[k].f = code[k + 1].a == 4 ? SHL : SHR;
+    code[k].a = n;
+    dead[k + 1] = 1;
+    return 1;
+}
+
+/* LIT d; OPR 5  =>  DVM s md >= 3Ҳ2 */
+static int recip(int k) {
+    if (code[k].a < 3 || log2of(code[k].a) > 0 || code[k + 1].a != 5 || fusable(k)) {
+        return 0;
+    }
+    code[k].f = DVM;
+    magic(code[k].a, &code[k].a, &code[k].l);
+    dead[k + 1] = 1;
+    return 1;
+}
+
+static struct prule srules[] = {
+    {"zeroprod",  3, {P_PUSH, LIT, OPR}, zeroprod},
+    {"selfop",    3, {LOD, LOD, OPR},    selfop},
+    {"constleft", 3, {LIT, P_PUSH, OPR}, constleft},
+    {"identity",  2, {LIT, OPR},         identity},
+    {"shift",     2, {LIT, OPR},         shift},
+    {"recip",     2, {LIT, OPR},         recip}
+};
+
+#define NSRULES (int)(sizeof(srules) / sizeof(srules[0]))
+
+/* ǿɾȥָ */
+int strength() {
+    return runrules(srules, NSRULES);
+}
+
+/*
+ * ָѳָидΪһںָֻдָ
+ * 룬ָԭΪִʱ˵ַ䣬
+ * ضλڲתĿʱںϡںϵ
+ */
+int superinstr() {
+    static char target[CXMAX];
+    enum fct f;
+    int k, j, len, n = 0;
+    
+    marktargets(target);
+    for (k = 0; k < cx; k += len) {
+        len = 1;
+        if (isop(k, LOD) && isop(k + 1, LIT) && isopr(k + 2, 2, 5) && isop(k + 3, STO)) {
+            f = UPD;
+            len = 4;
+        } else if (isop(k, LOD) && isop(k + 1, LOD) && isrel(k + 2)) {
+            f = JVV;
+            len = 3;
+        } else if (isop(k, LOD) && isop(k + 1, LIT) && isrel(k + 2)) {
+            f = JVC;
+            len = 3;
+        } else if (isop(k, LIT) && isop(k + 1, STO)) {
+            f = STC;
+            len = 2;
+        }
+        for (j = 1; j < len; j++) {
+            if (target[k + j]) {
+                len = 1;
+            }
+        }
+        if (len > 1) {
+            code[k].f = f;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* ִиŻ */
+void optimize() {
+    int n;
+    
+    if (opt_fold && vm_stats) {
+        printf("Folded: %d operations, %d conditions\n", fold_exprs, fold_conds);
+    }
+    if (opt_sccp) {
+        n = sccp();
+        if (vm_stats) {
+            printf("SCCP: %d values made constant, %d branches resolved, %d instructions removed\n",
+                   sccp_consts, sccp_branches, n);
+        }
+    }
+    if (opt_dce) {
+        n = dce();
+        if (vm_stats) {
+            printf("DCE: %d instructions removed, %d unreachable, %d dead stores\n",
+                   n, dce_unreachable, dce_stores);
+        }
+    }
+    if (opt_licm) {
+        n = licm();
+        if (vm_stats) {
+            printf("LICM: %d expressions hoisted from %d loops\n", n, licm_loops);
+        }
+    }
+    if (opt_strength) {
+        n = strength();
+        if (vm_stats) {
+            printf("Strength: %d instructions removed", n);
+            printrules(srules, NSRULES);
+        }
+    }
+    if (opt_peephole) {
+        n = peephole();
+        if (vm_stats) {
+            printf("Peephole: %d instructions removed", n);
+            printrules(prules, NPRULES);
+        }
+    }
+    if (opt_super) {
+        n = superinstr();
+        if (vm_stats) {
+            printf("Superinstructions: %d fused\n", n);
+        }
+    }
+}
@@ -3,20 +3,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <limits.h>
 #include "pl0.h"
 #include "pl0.tab.h"
 
 /* ȫֱ */
-char id[AL + 1];
+char *id;
 int num;
 struct instruction code[CXMAX];
 struct symbol table[TXMAX];
-char mnemonic[8][5] = {
-    "LIT", "OPR", "LOD", "STO", "CAL", "INT", "JMP", "JPC"
+char mnemonic[FCTCOUNT][5] = {
+    "LIT", "OPR", "LOD", "STO", "CAL", "INT", "JMP", "JPC",
+    "JEQ", "JNE", "JLT", "JGE", "JGT", "JLE", "JOD", "STK",
+    "SHL", "SHR", "DVM", "STC", "UPD", "JVV", "JVC"
 };
 
+/* ѡ */
+int vm_engine = ENGINE_SWITCH;  /* ִ */
+int vm_timing = 0;              /* Ƿʱ */
+int vm_stats = 0;               /* ǷͳϢ */
+long long vm_dispatch = 0;      /* зɵָ */
+static clock_t compile_start;   /* ʼʱ */
+static clock_t compile_end;     /* ʱ */
+char *engine_name[ENGINE_COUNT] = {
+    "switch", "threaded", "tos", "reg", "jit", "tier", "trace"
+};
+
+/*  */
+struct tinstr tcode[CXMAX];
+
 /* flex */
-extern FILE *yyin;
 extern int yyparse();
 
 /* Ϣ */
@@ -62,16 +79,38 @@ void error(int n) {
     err_count++;
 }
 
+/*
+ * űtable[1..tx]Ǽ˳ŵǰɼķţΪפ
+ * ַɢСͬһɢͰеķžlinkɢͷhashtab[]УǼǣνǰ
+ * ʱopenscope()tx˳ʱclosescope()ѹڵǼǵķ
+ * ȫķǸɢͷÿųջֻ
+ * һʱϵһͬžǵǰɼǸ
+ */
+static int hashtab[HASHSIZE];   /* ɢͷ0ʾ */
+static int scope[TXMAX];        /* ʼʱtx̵ķ */
+static int nscope = 0;          /* ջ */
+
+/* ʶɢֵ */
+static int hash(char *name) {
+    unsigned h = (unsigned)(size_t)name * 2654435761u;
+    return (h >> 16) & (HASHSIZE - 1);
+}
+
 /* ڷűеǼǷ */
 void enter(enum object kind) {
+    int h;
+    
     tx++;
-    if (tx > TXMAX) {
+    if (tx >= TXMAX) {
         printf("Program too long\n");
         exit(1);
     }
     
-    strcpy(table[tx].name, id);
+    table[tx].name = id;
     table[tx].kind = kind;
+    h = hash(id);
+    table[tx].link = hashtab[h];
+    hashtab[h] = tx;
     
     switch (kind) {
         case CONSTANT:
@@ -89,45 +128,39 @@ void enter(enum object kind) {
             
         case PROCEDURE_SYM:
             table[tx].level = level;
+            table[tx].adr = -1;    /* ڹʱ֪ */
+            table[tx].val = -1;    /* δʱɵCAL */
             break;
     }
 }
 
-/* ұʶڷűеλ */
+/* ұʶڷűеλãδҵ0 */
 int position(char *id) {
     int i;
-    strcpy(table[0].name, id);  /* ڱ */
-    i = tx;
-    
-    /* ӵǰλǰ֧Ƕ */
-    while (strcmp(table[i].name, id) != 0) {
-        i--;
-    }
-    
-    /* ҵڱi==0˵δҵ */
-    if (i == 0) {
-        return 0;
-    }
-    
-    /* ҵıʶǷڵǰɷʵ */
-    /* PL/0 ڲıʶ */
-    if (table[i].level <= level) {
-        return i;
-    }
-    
-    /* ҵıʶڸĲΣǰ */
-    int saved_i = i;
-    i--;
-    while (i > 0 && strcmp(table[i].name, id) != 0) {
-        i--;
+    for (i = hashtab[hash(id)]; i != 0; i = table[i].link) {
+        if (table[i].name == id) {
+            return i;
+        }
     }
-    
-    if (i > 0 && table[i].level <= level) {
-        return i;
+    return 0;
+}
+
+/* յǼǵĹ̵ */
+void openscope() {
+    scope[nscope++] = tx;
+}
+
+/* ˳ǰ򣬵еǼǵķ */
+void closescope() {
+    int mark = scope[--nscope];
+    for (; tx > mark; tx--) {
+        hashtab[hash(table[tx].name)] = table[tx].link;
     }
-    
-    /* ûҵʵģصһҵģܱ */
-    return saved_i;
+}
+
+/* ǰ̵ķţ򷵻0 */
+int curproc() {
+    return nscope > 0 ? scope[nscope - 1] : 0;
 }
 
 /* ָ */
@@ -142,6 +175,48 @@ void gen(enum fct f, int l, int a) {
     cx++;
 }
 
+/*
+ * WHILEѭתȰ˳ɣsavecond()condbuf
+ * ռ䣬ѭϺrestorecond()ŵѭĩβѭǶ
+ * ϸȳcondbufջʹá
+ */
+static struct instruction condbuf[CXMAX];
+static int condtop = 0;
+
+/* code[from..cx)벢գcondbufеλ */
+int savecond(int from) {
+    int mark = condtop;
+    int k;
+    for (k = from; k < cx; k++) {
+        condbuf[condtop++] = code[k];
+    }
+    cx = from;
+    return mark;
+}
+
+/*
+ * mark룬ĩβתΪʱtarget
+ * ֪gencond()ûдʱΪJMPֻJMPʱ
+ * 㲻ת
+ */
+void restorecond(int mark, int target) {
+    struct instruction *j = &condbuf[condtop - 1];
+    int k;
+    if (condtop == mark) {
+        gen(JMP, 0, target);
+        return;
+    }
+    for (k = mark; k < condtop - 1; k++) {
+        gen(condbuf[k].f, condbuf[k].l, condbuf[k].a);
+    }
+    if (j->f == JOD) {
+        gen(JOD, !j->l, target);
+    } else if (j->f != JMP) {
+        gen(JEQ + ((j->f - JEQ) ^ 1), 0, target);  /* ȡϵ */
+    }
+    condtop = mark;
+}
+
 /* б */
 void listcode(int from, int to) {
     int i;
@@ -151,29 +226,164 @@ void listcode(int from, int to) {
     }
 }
 
-/* ̬ͨlĻַ */
-int base(int l, int b, int s[]) {
-    int b1 = b;
-    while (l > 0) {
-        b1 = s[b1];
-        l--;
+/* ѡִ棬Чʱ0 */
+int setengine(char *name) {
+    int k;
+    for (k = 0; k < ENGINE_COUNT; k++) {
+        if (strcmp(name, engine_name[k]) == 0) {
+            vm_engine = k;
+            return 1;
+        }
     }
-    return b1;
+    return 0;
+}
+
+/* ¼ʱ䣬-tʱʱһ */
+void compiled() {
+    compile_end = clock();
+}
+
+/*
+ * ÿɴCALʱַ򷵻-1Ŀǹڣ
+ * ̵Ĳ1~LEVMAX֮䡣displayֻLEVMAX + 1ִ
+ * ִCALʱټΡ
+ */
+static int checkcalls() {
+    struct proc *p;
+    int j, k, lev;
+    
+    for (k = 0; k < cx; k++) {
+        if (code[k].f == CAL && (code[k].a <= 0 || code[k].a >= cx || code[code[k].a].f != INT)) {
+            return k;
+        }
+    }
+    findprocs();
+    for (j = 0; j < nprocs; j++) {
+        p = &procs[j];
+        for (k = p->entry; k <= p->end; k++) {
+            if (code[k].f != CAL) {
+                continue;
+            }
+            lev = p->level - code[k].l + 1;
+            if (lev < 1 || lev > LEVMAX || procat[code[k].a] < 0
+                || procs[procat[code[k].a]].level != lev) {
+                return k;
+            }
+        }
+    }
+    return -1;
 }
 
 /* ִ */
 void interpret() {
+    clock_t start;
+    void (*run)();
+    int ret;
+    
+    ret = checkcalls();
+    if (ret >= 0) {
+        printf("\nError: invalid call at %d\n", ret);
+        return;
+    }
+    /* Ļ¼s[1]ռcode[0]INT */
+    if (vm_stacksize <= code[code[0].a].a) {
+        printf("Invalid stack size %d (main program needs %d words)\n",
+               vm_stacksize, code[code[0].a].a + 1);
+        return;
+    }
+    printf("\n=== RUNNING PL/0 ===\n");
+    start = clock();
+    
+    switch (vm_engine) {
+        case ENGINE_THREADED:
+            run = run_threaded;
+            break;
+        case ENGINE_TOS:
+            run = run_tos;
+            break;
+        case ENGINE_REG:
+            run = run_reg;
+            break;
+        case ENGINE_JIT:
+            run = run_jit;
+            break;
+        case ENGINE_TIER:
+            run = run_tier;
+            break;
+        case ENGINE_TRACE:
+            run = run_trace;
+            break;
+        default:
+            run = run_switch;
+            break;
+    }
+    vm_catch();
+    ret = stack_run(run);
+    vm_flush();
+    if (ret < 0) {
+        printf("\nError: runtime stack overflow (%d words)\n", vm_stacksize);
+    }
+    
+    printf("\n=== END PL/0 ===\n");
+    if (vm_stats) {
+        printf("Dispatched: %lld instructions\n", vm_dispatch);
+    }
+    if (vm_timing) {
+        printf("Compile: %.3f s\n", (double)(compile_end - compile_start) / CLOCKS_PER_SEC);
+        printf("Engine %s: %.3f s\n", engine_name[vm_engine],
+               (double)(clock() - start) / CLOCKS_PER_SEC);
+    }
+}
+
+/*
+ * ʱdisplayѰַdisplay[k]Ϊǰɼĵk¼ַ
+ * ʲΪlıֻһβؾ̬ݡ
+ * ¼ǰԪΪ
+ *   s[b]     εøǵdisplayʱָ
+ *   s[b + 1] ̬߻ַ
+ *   s[b + 2] صַ
+ * ̵Ĳ = ߲ - l + 1ʱ߲ɷصַǰ
+ * CALĲ˻¼ⱣΡ
+ */
+
+/* 㣬opΪOPR 2~5 */
+static int arith(int op, int x, int y) {
+    switch (op) {
+        case 2: return x + y;
+        case 3: return x - y;
+        case 4: return x * y;
+        default: return x / y;
+    }
+}
+
+/* ϵ㣬fΪJEQ~JLE */
+static int relop(enum fct f, int x, int y) {
+    switch (f) {
+        case JEQ: return x == y;
+        case JNE: return x != y;
+        case JLT: return x < y;
+        case JGE: return x >= y;
+        case JGT: return x > y;
+        default:  return x <= y;
+    }
+}
+
+/* switchɽ */
+void run_switch() {
     int p = 0;      /*  */
     int b = 1;      /* ַĴ */
     int t = 0;      /* ջĴ */
-    int s[STACKSIZE] = {0};  /* ջ */
+    int lev = 0;    /* ǰ */
+    int display[LEVMAX + 1];  /* ¼ַ */
+    int *s = vm_stack;       /* ջ */
     struct instruction i;    /* ǰָ */
+    long long n = 0;         /* ɼ */
     
-    printf("\n=== RUNNING PL/0 ===\n");
-    s[1] = s[2] = s[3] = 0;
+    display[0] = b;
     
     do {
         i = code[p++];
+        n++;
         
         switch (i.f) {
             case LIT:
@@ -184,8 +394,12 @@ void interpret() {
                 switch (i.a) {
                     case 0:  /*  */
                         t = b - 1;
+                        display[lev] = s[t + 1];
                         p = s[t + 3];
                         b = s[t + 2];
+                        if (p != 0) {
+                            lev = lev - 1 + code[p - 1].l;
+                        }
                         break;
                     case 1:  /* ȡ */
                         s[t] = -s[t];
@@ -207,7 +421,7 @@ void interpret() {
                         s[t] = s[t] / s[t + 1];
                         break;
                     case 6:  /* ODD */
-                        s[t] = s[t] % 2;
+                        s[t] = s[t] & 1;
                         break;
                     case 8:  /*  */
                         t--;
@@ -234,35 +448,36 @@ void interpret() {
                         s[t] = (s[t] <= s[t + 1]);
                         break;
                     case 14: /* ջ */
-                        printf("%d ", s[t]);
+                        vm_write(s[t]);
                         t--;
                         break;
                     case 15: /*  */
-                        printf("\n");
+                        vm_writeln();
                         break;
                     case 16: /*  */
                         t++;
-                        printf("? ");
-                        scanf("%d", &s[t]);
+                        s[t] = vm_read();
                         break;
                 }
                 break;
                 
             case LOD:
                 t++;
-                s[t] = s[base(i.l, b, s) + i.a];
+                s[t] = s[display[lev - i.l] + i.a];
                 break;
                 
             case STO:
-                s[base(i.l, b, s) + i.a] = s[t];
+                s[display[lev - i.l] + i.a] = s[t];
                 t--;
                 break;
                 
             case CAL:
-                s[t + 1] = base(i.l, b, s);
+                lev = lev - i.l + 1;
+                s[t + 1] = display[lev];
                 s[t + 2] = b;
                 s[t + 3] = p;
                 b = t + 1;
+                display[lev] = b;
                 p = i.a;
                 break;
                 
@@ -280,27 +495,385 @@ void interpret() {
                 }
                 t--;
                 break;
+                
+            case JEQ:
+            case JNE:
+            case JLT:
+            case JGE:
+            case JGT:
+            case JLE:
+                t -= 2;
+                if (!relop(i.f, s[t + 1], s[t + 2])) {
+                    p = i.a;
+                }
+                break;
+                
+            case JOD:
+                if ((s[t] & 1) == i.l) {
+                    p = i.a;
+                }
+                t--;
+                break;
+                
+            case STK:
+                s[display[lev - i.l] + i.a] = s[t];
+                break;
+                
+            case SHL:
+                s[t] = SHLK(s[t], i.a);
+                break;
+                
+            case SHR:
+                s[t] = SHRK(s[t], i.a);
+                break;
+                
+            case DVM:
+                s[t] = DIVM(s[t], i.a, i.l);
+                break;
+                
+            /* ָȡcode[p]... */
+            case STC:
+                s[display[lev - code[p].l] + code[p].a] = i.a;
+                p += 1;
+                break;
+                
+            case UPD:
+                s[display[lev - code[p + 2].l] + code[p + 2].a] =
+                    arith(code[p + 1].a, s[display[lev - i.l] + i.a], code[p].a);
+                p += 3;
+                break;
+                
+            case JVV:
+                if (relop(code[p + 1].f, s[display[lev - i.l] + i.a],
+                          s[display[lev - code[p].l] + code[p].a])) {
+                    p += 2;
+                } else {
+                    p = code[p + 1].a;
+                }
+                break;
+                
+            case JVC:
+                if (relop(code[p + 1].f, s[display[lev - i.l] + i.a], code[p].a)) {
+                    p += 2;
+                } else {
+                    p = code[p + 1].a;
+                }
+                break;
         }
     } while (p != 0);
     
-    printf("\n=== END PL/0 ===\n");
+    vm_dispatch = n;
 }
 
+#if defined(__GNUC__)
+/* ֱȰcode[]ԤΪ(̵ַ, l, a)У
+ * OPRӲҲԤʱչִʱÿָֻһcomputed goto */
+void run_threaded() {
+    static void *fcttab[] = {
+        &&f_lit, &&f_opr, &&f_lod, &&f_sto, &&f_cal, &&f_int, &&f_jmp, &&f_jpc,
+        &&f_jeq, &&f_jne, &&f_jlt, &&f_jge, &&f_jgt, &&f_jle, &&f_jod, &&f_stk,
+        &&f_shl, &&f_shr, &&f_dvm, &&f_stc, &&f_opr, &&f_opr, &&f_opr
+    };
+    static void *updtab[] = {
+        &&upd_add, &&upd_sub, &&upd_mul, &&upd_div
+    };
+    static void *jvvtab[] = {
+        &&jvv_eql, &&jvv_neq, &&jvv_lss, &&jvv_geq, &&jvv_gtr, &&jvv_leq
+    };
+    static void *jvctab[] = {
+        &&jvc_eql, &&jvc_neq, &&jvc_lss, &&jvc_geq, &&jvc_gtr, &&jvc_leq
+    };
+    static void *oprtab[] = {
+        &&o_ret, &&o_neg, &&o_add, &&o_sub, &&o_mul, &&o_div, &&o_odd, &&o_nop,
+        &&o_eql, &&o_neq, &&o_lss, &&o_geq, &&o_gtr, &&o_leq,
+        &&o_write, &&o_writeln, &&o_read
+    };
+    struct tinstr *ip;       /* ǰָ */
+    int b = 1;               /* ַĴ */
+    int t = 0;               /* ջĴ */
+    int lev = 0;             /* ǰ */
+    int display[LEVMAX + 1]; /* ¼ַ */
+    int *s = vm_stack;       /* ջ */
+    long long n = 0;         /* ɼ */
+    int k;
+    
+    /* Ԥ룬ָѡ */
+    for (k = 0; k < cx; k++) {
+        switch (code[k].f) {
+            case OPR:
+                tcode[k].op = (code[k].a >= 0 && code[k].a <= 16) ? oprtab[code[k].a] : &&o_nop;
+                break;
+            case UPD:
+                tcode[k].op = updtab[code[k + 2].a - 2];
+                break;
+            case JVV:
+                tcode[k].op = jvvtab[code[k + 2].f - JEQ];
+                break;
+            case JVC:
+                tcode[k].op = jvctab[code[k + 2].f - JEQ];
+                break;
+            default:
+                tcode[k].op = fcttab[code[k].f];
+                break;
+        }
+        tcode[k].l = code[k].l;
+        tcode[k].a = code[k].a;
+    }
+    
+#define NEXT()  goto *(n++, ++ip)->op
+#define JUMP(x) goto *(n++, ip = tcode + (x))->op
+#define VAR(k)  s[display[lev - ip[k].l] + ip[k].a]
+    
+    display[0] = b;
+    ip = tcode;
+    JUMP(0);
+    
+f_lit:
+    s[++t] = ip->a;
+    NEXT();
+f_lod:
+    t++;
+    s[t] = s[display[lev - ip->l] + ip->a];
+    NEXT();
+f_sto:
+    s[display[lev - ip->l] + ip->a] = s[t];
+    t--;
+    NEXT();
+f_stk:
+    s[display[lev - ip->l] + ip->a] = s[t];
+    NEXT();
+f_shl:
+    s[t] = SHLK(s[t], ip->a);
+    NEXT();
+f_shr:
+    s[t] = SHRK(s[t], ip->a);
+    NEXT();
+f_dvm:
+    s[t] = DIVM(s[t], ip->a, ip->l);
+    NEXT();
+f_cal:
+    lev = lev - ip->l + 1;
+    s[t + 1] = display[lev];
+    s[t + 2] = b;
+    s[t + 3] = ip - tcode + 1;
+    b = t + 1;
+    display[lev] = b;
+    JUMP(ip->a);
+f_int:
+    t += ip->a;
+    NEXT();
+f_jmp:
+    JUMP(ip->a);
+f_jpc:
+    if (s[t--] == 0) {
+        JUMP(ip->a);
+    }
+    NEXT();
+    
+#define JREL(name, op) \
+name: \
+    t -= 2; \
+    if (!(s[t + 1] op s[t + 2])) { \
+        JUMP(ip->a); \
+    } \
+    NEXT();
+    JREL(f_jeq, ==)
+    JREL(f_jne, !=)
+    JREL(f_jlt, <)
+    JREL(f_jge, >=)
+    JREL(f_jgt, >)
+    JREL(f_jle, <=)
+#undef JREL
+f_jod:
+    if ((s[t--] & 1) == ip->l) {
+        JUMP(ip->a);
+    }
+    NEXT();
+f_opr:  /* Ԥ󲻻ᵽ */
+o_nop:
+    NEXT();
+o_ret:
+    t = b - 1;
+    display[lev] = s[t + 1];
+    b = s[t + 2];
+    if (s[t + 3] == 0) {
+        vm_dispatch = n;
+        return;
+    }
+    ip = tcode + s[t + 3];
+    lev = lev - 1 + ip[-1].l;
+    n++;
+    goto *ip->op;
+o_neg:
+    s[t] = -s[t];
+    NEXT();
+o_add:
+    t--;
+    s[t] = s[t] + s[t + 1];
+    NEXT();
+o_sub:
+    t--;
+    s[t] = s[t] - s[t + 1];
+    NEXT();
+o_mul:
+    t--;
+    s[t] = s[t] * s[t + 1];
+    NEXT();
+o_div:
+    t--;
+    s[t] = s[t] / s[t + 1];
+    NEXT();
+o_odd:
+    s[t] = s[t] & 1;
+    NEXT();
+o_eql:
+    t--;
+    s[t] = (s[t] == s[t + 1]);
+    NEXT();
+o_neq:
+    t--;
+    s[t] = (s[t] != s[t + 1]);
+    NEXT();
+o_lss:
+    t--;
+    s[t] = (s[t] < s[t + 1]);
+    NEXT();
+o_geq:
+    t--;
+    s[t] = (s[t] >= s[t + 1]);
+    NEXT();
+o_gtr:
+    t--;
+    s[t] = (s[t] > s[t + 1]);
+    NEXT();
+o_leq:
+    t--;
+    s[t] = (s[t] <= s[t + 1]);
+    NEXT();
+o_write:
+    vm_write(s[t]);
+    t--;
+    NEXT();
+o_writeln:
+    vm_writeln();
+    NEXT();
+o_read:
+    t++;
+    s[t] = vm_read();
+    NEXT();
+    
+    /* ָ */
+f_stc:
+    VAR(1) = ip->a;
+    ip += 1;
+    NEXT();
+    
+#define UPD(name, op) \
+name: \
+    VAR(3) = VAR(0) op ip[1].a; \
+    ip += 3; \
+    NEXT();
+    UPD(upd_add, +)
+    UPD(upd_sub, -)
+    UPD(upd_mul, *)
+    UPD(upd_div, /)
+#undef UPD
+    
+#define JCMP(name, op, y) \
+name: \
+    if (VAR(0) op (y)) { \
+        ip += 2; \
+        NEXT(); \
+    } \
+    JUMP(ip[2].a);
+    JCMP(jvv_eql, ==, VAR(1))
+    JCMP(jvv_neq, !=, VAR(1))
+    JCMP(jvv_lss, <,  VAR(1))
+    JCMP(jvv_geq, >=, VAR(1))
+    JCMP(jvv_gtr, >,  VAR(1))
+    JCMP(jvv_leq, <=, VAR(1))
+    JCMP(jvc_eql, ==, ip[1].a)
+    JCMP(jvc_neq, !=, ip[1].a)
+    JCMP(jvc_lss, <,  ip[1].a)
+    JCMP(jvc_geq, >=, ip[1].a)
+    JCMP(jvc_gtr, >,  ip[1].a)
+    JCMP(jvc_leq, <=, ip[1].a)
+#undef JCMP
+    
+#undef NEXT
+#undef JUMP
+#undef VAR
+}
+#else
+/* ֧computed gotoı˻switch */
+void run_threaded() {
+    run_switch();
+}
+#endif
+
 /*  */
 int main(int argc, char *argv[]) {
     char filename[256];
+    char *input = NULL;   /* ǽļ */
+    int batch = 0;
+    int k;
+    long n;
+    char *end;
     
     printf("PL/0 Compiler (Flex & Bison version)\n");
     
-    if (argc > 1) {
-        strcpy(filename, argv[1]);
-    } else {
+    /* Уpl0 [-e ] [-T ֵ] [-S ջС] [-n] [-i ļ] [-a] [-t] [-s] [-O] [-fŻ] Դļ */
+    filename[0] = '\0';
+    for (k = 1; k < argc; k++) {
+        if (strcmp(argv[k], "-e") == 0 && k + 1 < argc) {
+            if (!setengine(argv[++k])) {
+                printf("Unknown engine %s\n", argv[k]);
+                return 1;
+            }
+        } else if (strcmp(argv[k], "-t") == 0) {
+            vm_timing = 1;
+        } else if (strcmp(argv[k], "-T") == 0 && k + 1 < argc) {
+            tier_threshold = atoi(argv[++k]);
+        } else if (strcmp(argv[k], "-S") == 0 && k + 1 < argc) {
+            /* Ҫݣıǰټ */
+            n = strtol(argv[++k], &end, 10);
+            if (end == argv[k] || *end != '\0' || n < 4 || n > INT_MAX / (int)sizeof(int)) {
+                printf("Invalid stack size %s\n", argv[k]);
+                return 1;
+            }
+            vm_stacksize = (int)n;
+        } else if (strcmp(argv[k], "-n") == 0) {
+            batch = 1;
+        } else if (strcmp(argv[k], "-i") == 0 && k + 1 < argc) {
+            batch = 1;
+            input = argv[++k];
+        } else if (strcmp(argv[k], "-a") == 0) {
+            ast_mode = 1;
+        } else if (strcmp(argv[k], "-s") == 0) {
+            vm_stats = 1;
+        } else if (strcmp(argv[k], "-O") == 0) {
+            setallopt();
+        } else if (strncmp(argv[k], "-f", 2) == 0) {
+            if (!setopt(argv[k] + 2)) {
+                printf("Unknown option %s\n", argv[k]);
+                return 1;
+            }
+        } else {
+            strcpy(filename, argv[k]);
+        }
+    }
+    
+    if (filename[0] == '\0') {
         printf("Input PL/0 source file: ");
         scanf("%s", filename);
     }
     
-    yyin = fopen(filename, "r");
-    if (!yyin) {
+    if (batch && !vm_input(input)) {
+        printf("Cannot open input file %s\n", input);
+        return 1;
+    }
+    
+    if (!src_open(filename)) {
         printf("Cannot open file %s\n", filename);
         return 1;
     }
@@ -313,8 +886,9 @@ int main(int argc, char *argv[]) {
     err_count = 0;
     
     printf("Compiling %s...\n", filename);
+    compile_start = clock();
     yyparse();
     
-    fclose(yyin);
+    src_close();
     return 0;
 }
@@ -6,13 +6,13 @@
 #include <stdio.h>
 
 /*  */
-#define TXMAX    100     /* ű */
-#define CXMAX    500     /*  */
-#define STACKSIZE 500    /* ʱջС */
+#define TXMAX    10000   /* ű */
+#define CXMAX    100000  /*  */
+#define HASHSIZE 4096    /* űɢͰ2 */
+#define STACKSIZE 500    /* ʱջʼŵ */
 #define LEVMAX   3       /* Ƕײ */
 #define AMAX     2047    /* ַϽ */
 #define NMAX     14      /* ֵλ */
-#define AL       10      /* ʶ󳤶 */
 
 /*  */
 enum object {
@@ -30,17 +30,63 @@ enum fct {
     CAL,    /* 4: ù */
     INT,    /* 5: ռ */
     JMP,    /* 6: ת */
-    JPC     /* 7: ת */
+    JPC,    /* 7: ת */
+    /* Ƚϲתջxջyϵʱת˳OPR 8~13һ */
+    JEQ,    /* 8: x = y ת */
+    JNE,    /* 9: x # y ת */
+    JLT,    /* 10: x < y ת */
+    JGE,    /* 11: x >= y ת */
+    JGT,    /* 12: x > y ת */
+    JLE,    /* 13: x <= y ת */
+    JOD,    /* 14: ջl=0ʱODDתl=1ʱת */
+    STK,    /* 15: ջݴ浽ջŻSTO;LODõ */
+    /* ǿstrength()ѳ˳Գдõ */
+    SHL,    /* 16: ջaλ2a */
+    SHR,    /* 17: ջ2aݣȡ */
+    DVM,    /* 18: ջԳaΪ˷ħlΪλ */
+    /* ָsuperinstr()дָõԭָΪ */
+    STC,    /* 19: LIT;STO            */
+    UPD,    /* 20: LOD;LIT;OPR;STO   볣 */
+    JVV,    /* 21: LOD;LOD;Jxx       Ƚϣת */
+    JVC     /* 22: LOD;LIT;Jxx       볣Ƚϣת */
+};
+#define FCTCOUNT (JVC + 1)  /* ָ */
+
+/* SHLSHRDVM㣬OPR 45ͬ */
+#define SHLK(x, k)     ((int)((unsigned)(x) << (k)))
+#define SHRK(x, k)     (((x) + ((x) >> 31 & ((1 << (k)) - 1))) >> (k))
+#define DIVM(x, m, s)  ((((int)((long long)(x) * (m) >> 32) + ((m) < 0 ? (x) : 0)) >> (s)) \
+                        + (int)((unsigned)(x) >> 31))
+
+/* ﷨иϽṹĽͣŽָ֮ */
+enum nodekind {
+    N_SEQ = FCTCOUNT,   /*  */
+    N_IF,               /* IF  THEN  */
+    N_WHILE,            /* WHILE  DO  */
+    N_PROC              /* ̻ */
+};
+
+/* ִ */
+enum engine {
+    ENGINE_SWITCH,      /* switchɽ */
+    ENGINE_THREADED,    /* Ԥ + computed goto */
+    ENGINE_TOS,         /* ջ + computed goto */
+    ENGINE_REG,         /* ַĴ */
+    ENGINE_JIT,         /* x86-64ģ弴ʱ */
+    ENGINE_TIER,        /* ִУȵ̼ʱ */
+    ENGINE_TRACE,       /* ִУȵѭ¼켣ʱ */
+    ENGINE_COUNT
 };
 
 /* űṹ */
 struct symbol {
-    char name[AL + 1];
+    char *name; /* פıʶ */
     enum object kind;
-    int val;    /* CONSTANTʹ */
+    int val;    /* CONSTANTֵPROCEDUREδʱCAL */
     int level;  /* ڲ */
     int adr;    /* ַ */
     int size;   /* PROCEDUREʹ */
+    int link;   /* ͬһɢͰǰһǼǵķţ0ʾβ */
 };
 
 /* ָṹ */
@@ -50,8 +96,54 @@ struct instruction {
     int a;       /* λƻ */
 };
 
+/* ָṹ */
+struct tinstr {
+    void *op;    /* ̵ַ */
+    int l;       /*  */
+    int a;       /* λƻתַ */
+};
+
+/* Ĵڸִв֮䴫״̬ */
+struct vmregs {
+    int t;       /* ջ */
+    int b;       /* ַ */
+    int lev;     /* ǰ */
+};
+
+/* 켣еһָ */
+#define TRACEMAX 1000    /* 켣ָ */
+struct traceop {
+    int k;       /* code[]ַ */
+    int taken;   /* תǷת */
+};
+
+/* ŵļϣ */
+struct varset {
+    int *v;
+    int n, size;
+};
+
+/* ̣findprocs()ҳ */
+struct proc {
+    int entry;   /* INTĵַ */
+    int end;     /* ĩβOPR 0ĵַ */
+    int level;   /*  */
+    struct varset mods;  /* ڼܸдġ߿ɼı */
+    struct varset refs;  /* ڼܶȡġ߿ɼı */
+};
+
+/* 飬buildblocks() */
+struct block {
+    int start, end;  /* ָ[start, end) */
+    int succ[2];     /* ˳ִתĺ̿飬-1ʾû */
+};
+
+#define VARID(lev, a)  ((lev) << 16 | (a))   /* ţԲַ */
+#define VARLEV(v)      ((v) >> 16)
+#define VARADR(v)      ((v) & 0xffff)
+
 /* ȫֱ */
-extern char id[AL + 1];  /* ǰʶ */
+extern char *id;         /* ǰʶ */
 extern int num;          /* ǰ */
 extern int cx;           /*  */
 extern int level;        /* ǰ */
@@ -68,13 +160,131 @@ void error(int n);
 /* ű */
 void enter(enum object kind);
 int position(char *id);
+char *intern(const char *s, int len);
+char *intern_span(const char *s, int len);
+
+/* Դλ */
+extern long src_offset;          /* һǺֽ֮ƫ */
+void src_text(const char *p, long n);
+void src_position(long off, int *line, int *col);
+int src_open(const char *name);
+void src_buffer(const char *p, long n);
+void src_close();
+void openscope();
+void closescope();
+int curproc();
 
 /*  */
 void gen(enum fct f, int l, int a);
 void listcode(int from, int to);
+int savecond(int from);
+void restorecond(int mark, int target);
+
+/* ﷨ */
+extern int ast_mode;     /* ﷨ɴ */
+int mknode(int kind, int l, int a, int x, int y);
+int gennode(enum fct f, int l, int a, int x, int y);
+int gencond(enum fct f, int x, int y);
+extern int fold_exprs;   /* ۵ */
+extern int fold_conds;   /* ֪ */
+int append(int list, int k);
+int setproc(int k, int size, int procs, int body);
+void astgen(int root);
+void astfree();
+
+/* Ż */
+extern int opt_fold;     /* ۵ */
+extern int opt_peephole; /* Ż */
+extern int opt_super;    /* ָ */
+extern int opt_sccp;     /*  */
+extern int opt_dce;      /* ɾ */
+extern int opt_licm;     /* ѭ */
+extern int opt_strength; /* ǿ */
+int setopt(char *arg);
+void setallopt();
+void optimize();
+int peephole();
+int strength();
+int superinstr();
+int isjump(enum fct f);
+void discard(int k);
+int insertcode(int k, struct instruction *seq, int n);
+int compact();
+
+/* ͼ */
+extern struct proc procs[TXMAX];
+extern int nprocs;
+extern int procat[CXMAX];        /* ԸõַΪڵḶ́-1ʾ */
+extern struct block blocks[CXMAX];
+extern int blockat[CXMAX];       /* ָڵĿ */
+extern int varids[CXMAX];        /* numbervars()ŶӦı */
+int findprocs();
+int buildblocks(struct proc *p);
+int numbervars(struct proc *p);
+int varno(int v);
+int varof(struct proc *p, int k);
+int inset(struct varset *s, int v);
+
+/*  */
+extern int sccp_consts;          /* дΪLITֵ */
+extern int sccp_branches;        /* ȥת */
+int sccp();
+
+/* ɾ */
+extern int dce_unreachable;      /* ɾȥĲɴָ */
+extern int dce_stores;           /* ɾȥ洢 */
+int dce();
+
+/* ѭ */
+extern int licm_hoisted;         /*  */
+extern int licm_loops;           /* ѭ */
+int licm();
+
+/* ѡ */
+extern int vm_engine;    /* ִ */
+extern int vm_timing;    /* Ƿʱ */
+extern int vm_stats;     /* ǷͳϢ */
+extern long long vm_dispatch;  /* зɵָ */
+extern char *engine_name[ENGINE_COUNT];
+int setengine(char *name);
+void compiled();
 
 /*  */
 void interpret();
-int base(int l, int b, int s[]);
+void run_switch();
+void run_threaded();
+void run_tos();
+void run_reg();
+void run_jit();
+void run_tier();
+void run_trace();
+
+/* ʱ */
+int jit_init(int tier);
+void jit_free();
+int jit_compile(int from, int to);
+int jit_compiled(int k);
+void jit_enter(int k, int *s, int *display, struct vmregs *r);
+int jit_trace(struct traceop *tr, int n, int lev);
+int jit_run_trace(int off, int *s, int *display, struct vmregs *r);
+
+/*  */
+void vm_write(int x);
+void vm_writeln();
+int vm_read();
+extern int vm_batch;             /* ǽ */
+int vm_input(const char *name);
+void vm_flush();
+void vm_catch();
+
+/* ʱջ */
+extern int vm_stacksize;         /*  */
+extern int *vm_stack;
+int stack_run(void (*run)());
+
+/* ֲִ */
+extern int tier_threshold;       /* ȵֵ켣¼ */
+extern struct vmregs tier_regs;  /* tier_call()غtb */
+void tier_call(int p, int t, int b, int lev);
 
 #endif /* PL0_H */
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -60,14 +63,10 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
 
 
-/* Copy the first part of user declarations.  */
 
-/* Line 189 of yacc.c  */
+/* First part of user prologue.  */
 #line 3 "pl0.y"
 
 #include <stdio.h>
@@ -77,8 +76,6 @@
 
 extern int yylex();
 extern void yyerror(const char *s);
-extern int line_no;
-extern int col_no;
 extern FILE *yyin;
 
 /* 全局变量 */
@@ -97,131 +94,197 @@ int position(char *id);
 void gen(enum fct f, int l, int a);
 void error(int n);
 void listcode(int from, int to);
+void optimize();
+void compiled();
 void interpret();
 
 
+#line 103 "pl0.tab.c"
 
-/* Line 189 of yacc.c  */
-#line 106 "pl0.tab.c"
-
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUMBER = 258,
-     IDENT = 259,
-     CONST = 260,
-     VAR = 261,
-     PROCEDURE = 262,
-     CALL = 263,
-     BEGIN_SYM = 264,
-     END = 265,
-     IF = 266,
-     THEN = 267,
-     WHILE = 268,
-     DO = 269,
-     ODD = 270,
-     READ = 271,
-     WRITE = 272,
-     ASSIGN = 273,
-     EQ = 274,
-     NE = 275,
-     LT = 276,
-     LE = 277,
-     GT = 278,
-     GE = 279,
-     PLUS = 280,
-     MINUS = 281,
-     TIMES = 282,
-     SLASH = 283,
-     LPAREN = 284,
-     RPAREN = 285,
-     COMMA = 286,
-     SEMICOLON = 287,
-     PERIOD = 288,
-     UMINUS = 289
-   };
-#endif
-
-
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+#include "pl0.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NUMBER = 3,                     /* NUMBER  */
+  YYSYMBOL_IDENT = 4,                      /* IDENT  */
+  YYSYMBOL_CONST = 5,                      /* CONST  */
+  YYSYMBOL_VAR = 6,                        /* VAR  */
+  YYSYMBOL_PROCEDURE = 7,                  /* PROCEDURE  */
+  YYSYMBOL_CALL = 8,                       /* CALL  */
+  YYSYMBOL_BEGIN_SYM = 9,                  /* BEGIN_SYM  */
+  YYSYMBOL_END = 10,                       /* END  */
+  YYSYMBOL_IF = 11,                        /* IF  */
+  YYSYMBOL_THEN = 12,                      /* THEN  */
+  YYSYMBOL_WHILE = 13,                     /* WHILE  */
+  YYSYMBOL_DO = 14,                        /* DO  */
+  YYSYMBOL_ODD = 15,                       /* ODD  */
+  YYSYMBOL_READ = 16,                      /* READ  */
+  YYSYMBOL_WRITE = 17,                     /* WRITE  */
+  YYSYMBOL_ASSIGN = 18,                    /* ASSIGN  */
+  YYSYMBOL_EQ = 19,                        /* EQ  */
+  YYSYMBOL_NE = 20,                        /* NE  */
+  YYSYMBOL_LT = 21,                        /* LT  */
+  YYSYMBOL_LE = 22,                        /* LE  */
+  YYSYMBOL_GT = 23,                        /* GT  */
+  YYSYMBOL_GE = 24,                        /* GE  */
+  YYSYMBOL_PLUS = 25,                      /* PLUS  */
+  YYSYMBOL_MINUS = 26,                     /* MINUS  */
+  YYSYMBOL_TIMES = 27,                     /* TIMES  */
+  YYSYMBOL_SLASH = 28,                     /* SLASH  */
+  YYSYMBOL_LPAREN = 29,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 30,                    /* RPAREN  */
+  YYSYMBOL_COMMA = 31,                     /* COMMA  */
+  YYSYMBOL_SEMICOLON = 32,                 /* SEMICOLON  */
+  YYSYMBOL_PERIOD = 33,                    /* PERIOD  */
+  YYSYMBOL_UMINUS = 34,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 35,                  /* $accept  */
+  YYSYMBOL_program = 36,                   /* program  */
+  YYSYMBOL_block = 37,                     /* block  */
+  YYSYMBOL_38_1 = 38,                      /* @1  */
+  YYSYMBOL_39_2 = 39,                      /* $@2  */
+  YYSYMBOL_declaration_list = 40,          /* declaration_list  */
+  YYSYMBOL_declaration = 41,               /* declaration  */
+  YYSYMBOL_const_declaration = 42,         /* const_declaration  */
+  YYSYMBOL_const_list = 43,                /* const_list  */
+  YYSYMBOL_const_def = 44,                 /* const_def  */
+  YYSYMBOL_var_declaration = 45,           /* var_declaration  */
+  YYSYMBOL_var_list = 46,                  /* var_list  */
+  YYSYMBOL_proc_declaration = 47,          /* proc_declaration  */
+  YYSYMBOL_48_3 = 48,                      /* @3  */
+  YYSYMBOL_statement = 49,                 /* statement  */
+  YYSYMBOL_assignment_statement = 50,      /* assignment_statement  */
+  YYSYMBOL_call_statement = 51,            /* call_statement  */
+  YYSYMBOL_compound_statement = 52,        /* compound_statement  */
+  YYSYMBOL_statement_list = 53,            /* statement_list  */
+  YYSYMBOL_if_statement = 54,              /* if_statement  */
+  YYSYMBOL_while_statement = 55,           /* while_statement  */
+  YYSYMBOL_56_4 = 56,                      /* @4  */
+  YYSYMBOL_57_5 = 57,                      /* @5  */
+  YYSYMBOL_read_statement = 58,            /* read_statement  */
+  YYSYMBOL_read_list = 59,                 /* read_list  */
+  YYSYMBOL_write_statement = 60,           /* write_statement  */
+  YYSYMBOL_write_list = 61,                /* write_list  */
+  YYSYMBOL_condition = 62,                 /* condition  */
+  YYSYMBOL_rel_op = 63,                    /* rel_op  */
+  YYSYMBOL_expression = 64,                /* expression  */
+  YYSYMBOL_term = 65,                      /* term  */
+  YYSYMBOL_factor = 66                     /* factor  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Line 214 of yacc.c  */
-#line 35 "pl0.y"
-
-    int number;
-    char *ident;
 
 
 
-/* Line 214 of yacc.c  */
-#line 183 "pl0.tab.c"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
-
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 264 of yacc.c  */
-#line 195 "pl0.tab.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -229,55 +292,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -294,11 +408,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -306,8 +420,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -321,88 +435,89 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  4
 /* YYLAST -- Last index in YYTABLE.  */
@@ -414,18 +529,23 @@ union yyalloc
 #define YYNNTS  32
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  61
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  106
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   289
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -459,141 +579,64 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     6,     7,     8,    13,    14,    17,    19,
-      21,    23,    27,    29,    33,    37,    41,    43,    47,    48,
-      55,    56,    58,    60,    62,    64,    66,    68,    70,    74,
-      77,    81,    83,    87,    92,    93,    94,   101,   106,   108,
-     112,   117,   119,   123,   126,   130,   132,   134,   136,   138,
-     140,   142,   144,   147,   150,   154,   158,   160,   164,   168,
-     170,   172
+       0,    63,    63,    87,   100,    87,   134,   137,   144,   145,
+     146,   150,   154,   155,   159,   168,   172,   177,   186,   185,
+     211,   214,   215,   216,   217,   218,   219,   220,   224,   239,
+     258,   265,   269,   276,   292,   296,   291,   315,   322,   336,
+     352,   359,   363,   370,   374,   382,   383,   384,   385,   386,
+     387,   391,   392,   396,   400,   404,   411,   412,   416,   423,
+     443,   451
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      36,     0,    -1,    37,    33,    -1,    -1,    -1,    38,    40,
-      39,    49,    -1,    -1,    40,    41,    -1,    42,    -1,    45,
-      -1,    47,    -1,     5,    43,    32,    -1,    44,    -1,    43,
-      31,    44,    -1,     4,    19,     3,    -1,     6,    46,    32,
-      -1,     4,    -1,    46,    31,     4,    -1,    -1,     7,     4,
-      48,    32,    37,    32,    -1,    -1,    50,    -1,    51,    -1,
-      52,    -1,    54,    -1,    55,    -1,    58,    -1,    60,    -1,
-       4,    18,    64,    -1,     8,     4,    -1,     9,    53,    10,
-      -1,    49,    -1,    53,    32,    49,    -1,    11,    62,    12,
-      49,    -1,    -1,    -1,    13,    56,    62,    14,    57,    49,
-      -1,    16,    29,    59,    30,    -1,     4,    -1,    59,    31,
-       4,    -1,    17,    29,    61,    30,    -1,    64,    -1,    61,
-      31,    64,    -1,    15,    64,    -1,    64,    63,    64,    -1,
-      19,    -1,    20,    -1,    21,    -1,    24,    -1,    23,    -1,
-      22,    -1,    65,    -1,    25,    65,    -1,    26,    65,    -1,
-      64,    25,    65,    -1,    64,    26,    65,    -1,    66,    -1,
-      65,    27,    66,    -1,    65,    28,    66,    -1,     4,    -1,
-       3,    -1,    29,    64,    30,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,    53,    53,    68,    79,    68,    96,    98,   102,   103,
-     104,   108,   112,   113,   117,   127,   131,   137,   147,   146,
-     162,   164,   165,   166,   167,   168,   169,   170,   174,   189,
-     204,   208,   209,   213,   221,   225,   220,   236,   240,   253,
-     269,   276,   280,   287,   293,   302,   303,   304,   305,   306,
-     307,   311,   312,   313,   317,   321,   328,   329,   333,   340,
-     360,   368
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "NUMBER", "IDENT", "CONST", "VAR",
-  "PROCEDURE", "CALL", "BEGIN_SYM", "END", "IF", "THEN", "WHILE", "DO",
-  "ODD", "READ", "WRITE", "ASSIGN", "EQ", "NE", "LT", "LE", "GT", "GE",
-  "PLUS", "MINUS", "TIMES", "SLASH", "LPAREN", "RPAREN", "COMMA",
-  "SEMICOLON", "PERIOD", "UMINUS", "$accept", "program", "block", "@1",
-  "$@2", "declaration_list", "declaration", "const_declaration",
+  "\"end of file\"", "error", "\"invalid token\"", "NUMBER", "IDENT",
+  "CONST", "VAR", "PROCEDURE", "CALL", "BEGIN_SYM", "END", "IF", "THEN",
+  "WHILE", "DO", "ODD", "READ", "WRITE", "ASSIGN", "EQ", "NE", "LT", "LE",
+  "GT", "GE", "PLUS", "MINUS", "TIMES", "SLASH", "LPAREN", "RPAREN",
+  "COMMA", "SEMICOLON", "PERIOD", "UMINUS", "$accept", "program", "block",
+  "@1", "$@2", "declaration_list", "declaration", "const_declaration",
   "const_list", "const_def", "var_declaration", "var_list",
-  "proc_declaration", "$@3", "statement", "assignment_statement",
+  "proc_declaration", "@3", "statement", "assignment_statement",
   "call_statement", "compound_statement", "statement_list", "if_statement",
   "while_statement", "@4", "@5", "read_statement", "read_list",
   "write_statement", "write_list", "condition", "rel_op", "expression",
-  "term", "factor", 0
+  "term", "factor", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    35,    36,    38,    39,    37,    40,    40,    41,    41,
-      41,    42,    43,    43,    44,    45,    46,    46,    48,    47,
-      49,    49,    49,    49,    49,    49,    49,    49,    50,    51,
-      52,    53,    53,    54,    56,    57,    55,    58,    59,    59,
-      60,    61,    61,    62,    62,    63,    63,    63,    63,    63,
-      63,    64,    64,    64,    64,    64,    65,    65,    65,    66,
-      66,    66
-};
+#define YYPACT_NINF (-48)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     2,     0,     0,     4,     0,     2,     1,     1,
-       1,     3,     1,     3,     3,     3,     1,     3,     0,     6,
-       0,     1,     1,     1,     1,     1,     1,     1,     3,     2,
-       3,     1,     3,     4,     0,     0,     6,     4,     1,     3,
-       4,     1,     3,     2,     3,     1,     1,     1,     1,     1,
-       1,     1,     2,     2,     3,     3,     1,     3,     3,     1,
-       1,     3
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       3,     0,     0,     6,     1,     2,     4,     0,     0,     0,
-      20,     7,     8,     9,    10,     0,     0,    12,    16,     0,
-      18,     0,     0,    20,     0,    34,     0,     0,     5,    21,
-      22,    23,    24,    25,    26,    27,     0,     0,    11,     0,
-      15,     0,     0,    29,    31,     0,    60,    59,     0,     0,
-       0,     0,     0,     0,    51,    56,     0,     0,     0,    14,
-      13,    17,     3,    28,    30,    20,    43,    52,    53,     0,
-      20,    45,    46,    47,    50,    49,    48,     0,     0,     0,
-       0,     0,     0,    38,     0,     0,    41,     0,    32,    61,
-      33,    54,    55,    44,    57,    58,    35,    37,     0,    40,
-       0,    19,    20,    39,    42,    36
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     1,     2,     3,    10,     6,    11,    12,    16,    17,
-      13,    19,    14,    41,    28,    29,    30,    31,    45,    32,
-      33,    56,   102,    34,    84,    35,    85,    52,    79,    53,
-      54,    55
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -48
 static const yytype_int8 yypact[] =
 {
      -48,    32,   -11,   -48,   -48,   -48,    22,    36,    39,    46,
@@ -609,6 +652,24 @@ static const yytype_int8 yypact[] =
       10,   -48,    40,   -48,    20,   -48
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     0,     6,     1,     2,     4,     0,     0,     0,
+      20,     7,     8,     9,    10,     0,     0,    12,    16,     0,
+      18,     0,     0,    20,     0,    34,     0,     0,     5,    21,
+      22,    23,    24,    25,    26,    27,     0,     0,    11,     0,
+      15,     0,     0,    29,    31,     0,    60,    59,     0,     0,
+       0,     0,     0,     0,    51,    56,     0,     0,     0,    14,
+      13,    17,     3,    28,    30,    20,    43,    52,    53,     0,
+      20,    45,    46,    47,    50,    49,    48,     0,     0,     0,
+       0,     0,     0,    38,     0,     0,    41,     0,    32,    61,
+      33,    54,    55,    44,    57,    58,    35,    37,     0,    40,
+       0,    19,    20,    39,    42,    36
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
@@ -618,12 +679,19 @@ static const yytype_int8 yypgoto[] =
      -47,   -10
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     1,     2,     3,    10,     6,    11,    12,    16,    17,
+      13,    19,    14,    41,    28,    29,    30,    31,    45,    32,
+      33,    56,   102,    34,    84,    35,    85,    52,    79,    53,
+      54,    55
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       44,    63,    67,    68,    64,    37,    38,    66,    80,    81,
       69,    46,    47,    46,    47,    46,    47,    86,    39,    40,
@@ -636,7 +704,7 @@ static const yytype_uint8 yytable[] =
       96,   101,   103,    87,    60,    82
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int8 yycheck[] =
 {
       23,    42,    49,    50,    10,    31,    32,    48,    27,    28,
       51,     3,     4,     3,     4,     3,     4,    58,    31,    32,
@@ -649,9 +717,9 @@ static const yytype_uint8 yycheck[] =
       14,    32,     4,    62,    37,    56
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    36,    37,    38,     0,    33,    40,     5,     6,     7,
       39,    41,    42,    45,    47,     4,    43,    44,     4,    46,
@@ -666,95 +734,65 @@ static const yytype_uint8 yystos[] =
       31,    32,    57,     4,    64,    49
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    35,    36,    38,    39,    37,    40,    40,    41,    41,
+      41,    42,    43,    43,    44,    45,    46,    46,    48,    47,
+      49,    49,    49,    49,    49,    49,    49,    49,    50,    51,
+      52,    53,    53,    54,    56,    57,    55,    58,    59,    59,
+      60,    61,    61,    62,    62,    63,    63,    63,    63,    63,
+      63,    64,    64,    64,    64,    64,    65,    65,    65,    66,
+      66,    66
+};
 
-#define YYFAIL		goto yyerrlab
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     0,     0,     4,     0,     2,     1,     1,
+       1,     3,     1,     3,     3,     3,     1,     3,     0,     6,
+       0,     1,     1,     1,     1,     1,     1,     1,     3,     2,
+       3,     1,     3,     4,     0,     0,     6,     4,     1,     3,
+       4,     1,     3,     2,     3,     1,     1,     1,     1,     1,
+       1,     1,     2,     2,     3,     3,     1,     3,     3,     1,
+       1,     3
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -764,80 +802,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -845,16 +861,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -865,63 +873,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -936,342 +937,78 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
 
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/*----------.
+| yyparse.  |
+`----------*/
+
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-
-
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1279,133 +1016,140 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1420,8 +1164,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -1433,13 +1177,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1454,14 +1198,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1474,13 +1218,20 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
-#line 54 "pl0.y"
+  case 2: /* program: block PERIOD  */
+#line 64 "pl0.y"
     {
-        gen(OPR, 0, 0);  /* 返回指令 */
+        if (ast_mode) {
+            if (err_count == 0) {
+                astgen((yyvsp[-1].number));
+            }
+            astfree();
+        } else {
+            gen(OPR, 0, 0);  /* 返回指令 */
+        }
         if (err_count == 0) {
+            optimize();
+            compiled();
             printf("\nCompilation successful!\n");
             listcode(0, cx);
             printf("\nStart PL/0\n");
@@ -1488,477 +1239,546 @@ yyreduce:
         } else {
             printf("\n%d errors in PL/0 program\n", err_count);
         }
-    ;}
+    }
+#line 1244 "pl0.tab.c"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
-#line 68 "pl0.y"
+  case 3: /* @1: %empty  */
+#line 87 "pl0.y"
     {
         dx = 3;           /* 为链接数据预留空间 */
         int jmpaddr = cx;
-        gen(JMP, 0, 0);   /* 产生跳转指令，跳转地址未知 */
+        if (!ast_mode) {
+            gen(JMP, 0, 0);   /* 产生跳转指令，跳转地址未知 */
+        }
         
         if (level > LEVMAX) {
             error(32);    /* 嵌套层次过深 */
         }
         (yyval.number) = jmpaddr;
-    ;}
+    }
+#line 1261 "pl0.tab.c"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
-#line 79 "pl0.y"
+  case 4: /* $@2: %empty  */
+#line 100 "pl0.y"
     {
-        int jmpaddr = (yyvsp[(1) - (2)].number);
-        code[jmpaddr].a = cx;    /* 回填跳转地址 */
-        /* 如果是过程，记录其入口地址 */
-        int i;
-        for (i = tx; i > 0; i--) {
-            if (table[i].kind == PROCEDURE_SYM && table[i].adr == 0) {
+        if (!ast_mode) {
+            int jmpaddr = (yyvsp[-1].number);
+            code[jmpaddr].a = cx;    /* 回填跳转地址 */
+            /* 如果是过程，记录其入口地址 */
+            int i = curproc();
+            if (i != 0) {
+                /* 回填内层过程中调用本过程的CAL，链由其a域串起 */
+                int k, next;
+                for (k = table[i].val; k >= 0; k = next) {
+                    next = code[k].a;
+                    code[k].a = cx;
+                }
                 table[i].adr = cx;
                 table[i].size = dx;
-                break;
             }
+            gen(INT, 0, dx);         /* 分配空间 */
         }
-        gen(INT, 0, dx);         /* 分配空间 */
-    ;}
+    }
+#line 1285 "pl0.tab.c"
     break;
 
-  case 14:
-
-/* Line 1455 of yacc.c  */
-#line 118 "pl0.y"
+  case 5: /* block: @1 declaration_list $@2 statement  */
+#line 120 "pl0.y"
     {
-        strcpy(id, (yyvsp[(1) - (3)].ident));
-        num = (yyvsp[(3) - (3)].number);
-        enter(CONSTANT);
-        free((yyvsp[(1) - (3)].ident));
-    ;}
+        (yyval.number) = 0;
+        if (ast_mode) {
+            /* 过程结点在登记过程名时已分配 */
+            int i = curproc();
+            int k = i != 0 ? table[i].adr : mknode(N_PROC, 0, 0, 0, 0);
+            (yyval.number) = setproc(k, dx, (yyvsp[-2].number), (yyvsp[0].number));
+        }
+    }
+#line 1299 "pl0.tab.c"
     break;
 
-  case 16:
+  case 6: /* declaration_list: %empty  */
+#line 134 "pl0.y"
+    {
+        (yyval.number) = 0;
+    }
+#line 1307 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 132 "pl0.y"
+  case 7: /* declaration_list: declaration_list declaration  */
+#line 138 "pl0.y"
     {
-        strcpy(id, (yyvsp[(1) - (1)].ident));
-        enter(VARIABLE);
-        free((yyvsp[(1) - (1)].ident));
-    ;}
+        (yyval.number) = append((yyvsp[-1].number), (yyvsp[0].number));
+    }
+#line 1315 "pl0.tab.c"
     break;
 
-  case 17:
+  case 8: /* declaration: const_declaration  */
+#line 144 "pl0.y"
+                            { (yyval.number) = 0; }
+#line 1321 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 138 "pl0.y"
+  case 9: /* declaration: var_declaration  */
+#line 145 "pl0.y"
+                            { (yyval.number) = 0; }
+#line 1327 "pl0.tab.c"
+    break;
+
+  case 14: /* const_def: IDENT EQ NUMBER  */
+#line 160 "pl0.y"
     {
-        strcpy(id, (yyvsp[(3) - (3)].ident));
+        id = (yyvsp[-2].ident);
+        num = (yyvsp[0].number);
+        enter(CONSTANT);
+    }
+#line 1337 "pl0.tab.c"
+    break;
+
+  case 16: /* var_list: IDENT  */
+#line 173 "pl0.y"
+    {
+        id = (yyvsp[0].ident);
         enter(VARIABLE);
-        free((yyvsp[(3) - (3)].ident));
-    ;}
+    }
+#line 1346 "pl0.tab.c"
     break;
 
-  case 18:
+  case 17: /* var_list: var_list COMMA IDENT  */
+#line 178 "pl0.y"
+    {
+        id = (yyvsp[0].ident);
+        enter(VARIABLE);
+    }
+#line 1355 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 147 "pl0.y"
+  case 18: /* @3: %empty  */
+#line 186 "pl0.y"
     {
-        strcpy(id, (yyvsp[(2) - (2)].ident));
+        id = (yyvsp[0].ident);
         enter(PROCEDURE_SYM);
-        free((yyvsp[(2) - (2)].ident));
+        if (ast_mode) {
+            table[tx].adr = mknode(N_PROC, 0, 0, 0, 0);  /* 入口地址生成时才知道 */
+        }
+        openscope();
         level++;
+        (yyval.number) = dx;  /* 保存外层的数据分配索引 */
         dx = 3;  /* 重置数据分配索引 */
-    ;}
+    }
+#line 1371 "pl0.tab.c"
     break;
 
-  case 19:
-
-/* Line 1455 of yacc.c  */
-#line 155 "pl0.y"
+  case 19: /* proc_declaration: PROCEDURE IDENT @3 SEMICOLON block SEMICOLON  */
+#line 198 "pl0.y"
     {
-        gen(OPR, 0, 0);  /* 过程返回 */
+        if (!ast_mode) {
+            gen(OPR, 0, 0);  /* 过程返回 */
+        }
         level--;
-        /* 不重置tx，保留所有符号在符号表中 */
-    ;}
+        dx = (yyvsp[-3].number);  /* 恢复外层的数据分配索引 */
+        closescope();     /* 弹出过程内登记的符号 */
+        (yyval.number) = (yyvsp[-1].number);
+    }
+#line 1385 "pl0.tab.c"
     break;
 
-  case 28:
+  case 20: /* statement: %empty  */
+#line 211 "pl0.y"
+    {
+        (yyval.number) = 0;
+    }
+#line 1393 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 175 "pl0.y"
+  case 28: /* assignment_statement: IDENT ASSIGN expression  */
+#line 225 "pl0.y"
     {
-        int i = position((yyvsp[(1) - (3)].ident));
+        int i = position((yyvsp[-2].ident));
+        (yyval.number) = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != VARIABLE) {
             error(12);  /* 不能给常量或过程赋值 */
         } else {
-            gen(STO, level - table[i].level, table[i].adr);
+            (yyval.number) = gennode(STO, level - table[i].level, table[i].adr, (yyvsp[0].number), 0);
         }
-        free((yyvsp[(1) - (3)].ident));
-    ;}
+    }
+#line 1409 "pl0.tab.c"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
-#line 190 "pl0.y"
+  case 29: /* call_statement: CALL IDENT  */
+#line 240 "pl0.y"
     {
-        int i = position((yyvsp[(2) - (2)].ident));
+        int i = position((yyvsp[0].ident));
+        (yyval.number) = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != PROCEDURE_SYM) {
             error(15);  /* 调用非过程标识符 */
+        } else if (!ast_mode && table[i].adr < 0) {
+            /* 内层过程调用外层过程，入口未定，链入待回填的CAL */
+            gen(CAL, level - table[i].level, table[i].val);
+            table[i].val = cx - 1;
         } else {
-            gen(CAL, level - table[i].level, table[i].adr);
+            (yyval.number) = gennode(CAL, level - table[i].level, table[i].adr, 0, 0);
         }
-        free((yyvsp[(2) - (2)].ident));
-    ;}
+    }
+#line 1429 "pl0.tab.c"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
-#line 214 "pl0.y"
+  case 30: /* compound_statement: BEGIN_SYM statement_list END  */
+#line 259 "pl0.y"
     {
-        code[(yyvsp[(2) - (4)].number)].a = cx;  /* 回填跳转地址 */
-    ;}
+        (yyval.number) = (yyvsp[-1].number);
+    }
+#line 1437 "pl0.tab.c"
     break;
 
-  case 34:
+  case 31: /* statement_list: statement  */
+#line 266 "pl0.y"
+    {
+        (yyval.number) = append(0, (yyvsp[0].number));
+    }
+#line 1445 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 221 "pl0.y"
+  case 32: /* statement_list: statement_list SEMICOLON statement  */
+#line 270 "pl0.y"
     {
-        (yyval.number) = cx;  /* 保存循环开始地址 */
-    ;}
+        (yyval.number) = append((yyvsp[-2].number), (yyvsp[0].number));
+    }
+#line 1453 "pl0.tab.c"
     break;
 
-  case 35:
+  case 33: /* if_statement: IF condition THEN statement  */
+#line 277 "pl0.y"
+    {
+        if (ast_mode) {
+            (yyval.number) = mknode(N_IF, 0, 0, (yyvsp[-2].number), (yyvsp[0].number));
+        } else {
+            if ((yyvsp[-2].number) >= 0) {
+                code[(yyvsp[-2].number)].a = cx;  /* 回填跳转地址，条件恒成立时没有跳转 */
+            }
+            (yyval.number) = 0;
+        }
+    }
+#line 1468 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 225 "pl0.y"
+  case 34: /* @4: %empty  */
+#line 292 "pl0.y"
     {
-        (yyval.number) = (yyvsp[(3) - (4)].number);  /* 保存JPC地址 */
-    ;}
+        (yyval.number) = cx;  /* 保存循环开始地址 */
+    }
+#line 1476 "pl0.tab.c"
     break;
 
-  case 36:
+  case 35: /* @5: %empty  */
+#line 296 "pl0.y"
+    {
+        if (!ast_mode) {
+            (yyval.number) = savecond((yyvsp[-2].number));  /* 条件代码移到循环末尾 */
+            gen(JMP, 0, 0);                     /* 跳到条件判断，地址未知 */
+        }
+    }
+#line 1487 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 229 "pl0.y"
+  case 36: /* while_statement: WHILE @4 condition DO @5 statement  */
+#line 303 "pl0.y"
     {
-        gen(JMP, 0, (yyvsp[(2) - (6)].number));      /* 跳回循环开始 */
-        code[(yyvsp[(5) - (6)].number)].a = cx;      /* 回填条件跳转地址 */
-    ;}
+        if (ast_mode) {
+            (yyval.number) = mknode(N_WHILE, 0, 0, (yyvsp[-3].number), (yyvsp[0].number));
+        } else {
+            code[(yyvsp[-4].number)].a = cx;                   /* 回填入口跳转地址 */
+            restorecond((yyvsp[-1].number), (yyvsp[-4].number) + 1);   /* 条件成立时跳回循环体 */
+            (yyval.number) = 0;
+        }
+    }
+#line 1501 "pl0.tab.c"
     break;
 
-  case 38:
+  case 37: /* read_statement: READ LPAREN read_list RPAREN  */
+#line 316 "pl0.y"
+    {
+        (yyval.number) = (yyvsp[-1].number);
+    }
+#line 1509 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 241 "pl0.y"
+  case 38: /* read_list: IDENT  */
+#line 323 "pl0.y"
     {
-        int i = position((yyvsp[(1) - (1)].ident));
+        int i = position((yyvsp[0].ident));
+        (yyval.number) = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != VARIABLE) {
             error(12);  /* 只能读入变量 */
         } else {
-            gen(OPR, 0, 16);  /* 读操作 */
-            gen(STO, level - table[i].level, table[i].adr);
+            /* 读操作 */
+            (yyval.number) = append(0, gennode(STO, level - table[i].level, table[i].adr,
+                                   gennode(OPR, 0, 16, 0, 0), 0));
         }
-        free((yyvsp[(1) - (1)].ident));
-    ;}
+    }
+#line 1527 "pl0.tab.c"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
-#line 254 "pl0.y"
+  case 39: /* read_list: read_list COMMA IDENT  */
+#line 337 "pl0.y"
     {
-        int i = position((yyvsp[(3) - (3)].ident));
+        int i = position((yyvsp[0].ident));
+        (yyval.number) = (yyvsp[-2].number);
         if (i == 0) {
             error(11);
         } else if (table[i].kind != VARIABLE) {
             error(12);
         } else {
-            gen(OPR, 0, 16);
-            gen(STO, level - table[i].level, table[i].adr);
+            (yyval.number) = append((yyvsp[-2].number), gennode(STO, level - table[i].level, table[i].adr,
+                                    gennode(OPR, 0, 16, 0, 0), 0));
         }
-        free((yyvsp[(3) - (3)].ident));
-    ;}
+    }
+#line 1544 "pl0.tab.c"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
-#line 270 "pl0.y"
+  case 40: /* write_statement: WRITE LPAREN write_list RPAREN  */
+#line 353 "pl0.y"
     {
-        gen(OPR, 0, 15);  /* 输出换行 */
-    ;}
+        (yyval.number) = append((yyvsp[-1].number), gennode(OPR, 0, 15, 0, 0));  /* 输出换行 */
+    }
+#line 1552 "pl0.tab.c"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
-#line 277 "pl0.y"
+  case 41: /* write_list: expression  */
+#line 360 "pl0.y"
     {
-        gen(OPR, 0, 14);  /* 输出栈顶值 */
-    ;}
+        (yyval.number) = append(0, gennode(OPR, 0, 14, (yyvsp[0].number), 0));  /* 输出栈顶值 */
+    }
+#line 1560 "pl0.tab.c"
     break;
 
-  case 42:
-
-/* Line 1455 of yacc.c  */
-#line 281 "pl0.y"
+  case 42: /* write_list: write_list COMMA expression  */
+#line 364 "pl0.y"
     {
-        gen(OPR, 0, 14);
-    ;}
+        (yyval.number) = append((yyvsp[-2].number), gennode(OPR, 0, 14, (yyvsp[0].number), 0));
+    }
+#line 1568 "pl0.tab.c"
     break;
 
-  case 43:
-
-/* Line 1455 of yacc.c  */
-#line 288 "pl0.y"
+  case 43: /* condition: ODD expression  */
+#line 371 "pl0.y"
     {
-        gen(OPR, 0, 6);  /* ODD操作 */
-        (yyval.number) = cx;
-        gen(JPC, 0, 0);  /* 条件跳转 */
-    ;}
+        (yyval.number) = gencond(JOD, (yyvsp[0].number), 0);  /* ODD不成立则跳转 */
+    }
+#line 1576 "pl0.tab.c"
     break;
 
-  case 44:
-
-/* Line 1455 of yacc.c  */
-#line 294 "pl0.y"
+  case 44: /* condition: expression rel_op expression  */
+#line 375 "pl0.y"
     {
-        gen(OPR, 0, (yyvsp[(2) - (3)].number));  /* 关系运算 */
-        (yyval.number) = cx;
-        gen(JPC, 0, 0);           /* 条件跳转 */
-    ;}
+        (yyval.number) = gencond(JEQ + (yyvsp[-1].number) - 8, (yyvsp[-2].number), (yyvsp[0].number));  /* 关系不成立则跳转 */
+    }
+#line 1584 "pl0.tab.c"
     break;
 
-  case 45:
-
-/* Line 1455 of yacc.c  */
-#line 302 "pl0.y"
-    { (yyval.number) = 8; ;}
+  case 45: /* rel_op: EQ  */
+#line 382 "pl0.y"
+          { (yyval.number) = 8; }
+#line 1590 "pl0.tab.c"
     break;
 
-  case 46:
-
-/* Line 1455 of yacc.c  */
-#line 303 "pl0.y"
-    { (yyval.number) = 9; ;}
+  case 46: /* rel_op: NE  */
+#line 383 "pl0.y"
+          { (yyval.number) = 9; }
+#line 1596 "pl0.tab.c"
     break;
 
-  case 47:
-
-/* Line 1455 of yacc.c  */
-#line 304 "pl0.y"
-    { (yyval.number) = 10; ;}
+  case 47: /* rel_op: LT  */
+#line 384 "pl0.y"
+          { (yyval.number) = 10; }
+#line 1602 "pl0.tab.c"
     break;
 
-  case 48:
-
-/* Line 1455 of yacc.c  */
-#line 305 "pl0.y"
-    { (yyval.number) = 11; ;}
+  case 48: /* rel_op: GE  */
+#line 385 "pl0.y"
+          { (yyval.number) = 11; }
+#line 1608 "pl0.tab.c"
     break;
 
-  case 49:
-
-/* Line 1455 of yacc.c  */
-#line 306 "pl0.y"
-    { (yyval.number) = 12; ;}
+  case 49: /* rel_op: GT  */
+#line 386 "pl0.y"
+          { (yyval.number) = 12; }
+#line 1614 "pl0.tab.c"
     break;
 
-  case 50:
-
-/* Line 1455 of yacc.c  */
-#line 307 "pl0.y"
-    { (yyval.number) = 13; ;}
+  case 50: /* rel_op: LE  */
+#line 387 "pl0.y"
+          { (yyval.number) = 13; }
+#line 1620 "pl0.tab.c"
     break;
 
-  case 53:
-
-/* Line 1455 of yacc.c  */
-#line 314 "pl0.y"
+  case 52: /* expression: PLUS term  */
+#line 393 "pl0.y"
     {
-        gen(OPR, 0, 1);  /* 取负 */
-    ;}
+        (yyval.number) = (yyvsp[0].number);
+    }
+#line 1628 "pl0.tab.c"
     break;
 
-  case 54:
-
-/* Line 1455 of yacc.c  */
-#line 318 "pl0.y"
+  case 53: /* expression: MINUS term  */
+#line 397 "pl0.y"
     {
-        gen(OPR, 0, 2);  /* 加法 */
-    ;}
+        (yyval.number) = gennode(OPR, 0, 1, (yyvsp[0].number), 0);  /* 取负 */
+    }
+#line 1636 "pl0.tab.c"
     break;
 
-  case 55:
-
-/* Line 1455 of yacc.c  */
-#line 322 "pl0.y"
+  case 54: /* expression: expression PLUS term  */
+#line 401 "pl0.y"
     {
-        gen(OPR, 0, 3);  /* 减法 */
-    ;}
+        (yyval.number) = gennode(OPR, 0, 2, (yyvsp[-2].number), (yyvsp[0].number));  /* 加法 */
+    }
+#line 1644 "pl0.tab.c"
     break;
 
-  case 57:
-
-/* Line 1455 of yacc.c  */
-#line 330 "pl0.y"
+  case 55: /* expression: expression MINUS term  */
+#line 405 "pl0.y"
     {
-        gen(OPR, 0, 4);  /* 乘法 */
-    ;}
+        (yyval.number) = gennode(OPR, 0, 3, (yyvsp[-2].number), (yyvsp[0].number));  /* 减法 */
+    }
+#line 1652 "pl0.tab.c"
     break;
 
-  case 58:
-
-/* Line 1455 of yacc.c  */
-#line 334 "pl0.y"
+  case 57: /* term: term TIMES factor  */
+#line 413 "pl0.y"
     {
-        gen(OPR, 0, 5);  /* 除法 */
-    ;}
+        (yyval.number) = gennode(OPR, 0, 4, (yyvsp[-2].number), (yyvsp[0].number));  /* 乘法 */
+    }
+#line 1660 "pl0.tab.c"
     break;
 
-  case 59:
+  case 58: /* term: term SLASH factor  */
+#line 417 "pl0.y"
+    {
+        (yyval.number) = gennode(OPR, 0, 5, (yyvsp[-2].number), (yyvsp[0].number));  /* 除法 */
+    }
+#line 1668 "pl0.tab.c"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 341 "pl0.y"
+  case 59: /* factor: IDENT  */
+#line 424 "pl0.y"
     {
-        int i = position((yyvsp[(1) - (1)].ident));
+        int i = position((yyvsp[0].ident));
+        (yyval.number) = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else {
             switch (table[i].kind) {
                 case CONSTANT:
-                    gen(LIT, 0, table[i].val);
+                    (yyval.number) = gennode(LIT, 0, table[i].val, 0, 0);
                     break;
                 case VARIABLE:
-                    gen(LOD, level - table[i].level, table[i].adr);
+                    (yyval.number) = gennode(LOD, level - table[i].level, table[i].adr, 0, 0);
                     break;
                 case PROCEDURE_SYM:
                     error(21);  /* 表达式中不能有过程标识符 */
                     break;
             }
         }
-        free((yyvsp[(1) - (1)].ident));
-    ;}
+    }
+#line 1692 "pl0.tab.c"
     break;
 
-  case 60:
-
-/* Line 1455 of yacc.c  */
-#line 361 "pl0.y"
+  case 60: /* factor: NUMBER  */
+#line 444 "pl0.y"
     {
-        if ((yyvsp[(1) - (1)].number) > AMAX) {
+        if ((yyvsp[0].number) > AMAX) {
             error(30);  /* 数值越界 */
-            (yyvsp[(1) - (1)].number) = 0;
+            (yyvsp[0].number) = 0;
         }
-        gen(LIT, 0, (yyvsp[(1) - (1)].number));
-    ;}
+        (yyval.number) = gennode(LIT, 0, (yyvsp[0].number), 0, 0);
+    }
+#line 1704 "pl0.tab.c"
+    break;
+
+  case 61: /* factor: LPAREN expression RPAREN  */
+#line 452 "pl0.y"
+    {
+        (yyval.number) = (yyvsp[-1].number);
+    }
+#line 1712 "pl0.tab.c"
     break;
 
 
+#line 1716 "pl0.tab.c"
 
-/* Line 1455 of yacc.c  */
-#line 1873 "pl0.tab.c"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -1970,14 +1790,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1990,39 +1809,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2033,58 +1855,62 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 1675 of yacc.c  */
-#line 371 "pl0.y"
+#line 457 "pl0.y"
 
 
 void yyerror(const char *s) {
-    fprintf(stderr, "Error: %s at line %d, column %d\n", s, line_no, col_no);
+    int line, col;
+    src_position(src_offset, &line, &col);
+    fprintf(stderr, "Error: %s at line %d, column %d\n", s, line, col);
     err_count++;
 }
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,74 +27,91 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PL0_TAB_H_INCLUDED
+# define YY_YY_PL0_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUMBER = 258,
-     IDENT = 259,
-     CONST = 260,
-     VAR = 261,
-     PROCEDURE = 262,
-     CALL = 263,
-     BEGIN_SYM = 264,
-     END = 265,
-     IF = 266,
-     THEN = 267,
-     WHILE = 268,
-     DO = 269,
-     ODD = 270,
-     READ = 271,
-     WRITE = 272,
-     ASSIGN = 273,
-     EQ = 274,
-     NE = 275,
-     LT = 276,
-     LE = 277,
-     GT = 278,
-     GE = 279,
-     PLUS = 280,
-     MINUS = 281,
-     TIMES = 282,
-     SLASH = 283,
-     LPAREN = 284,
-     RPAREN = 285,
-     COMMA = 286,
-     SEMICOLON = 287,
-     PERIOD = 288,
-     UMINUS = 289
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NUMBER = 258,                  /* NUMBER  */
+    IDENT = 259,                   /* IDENT  */
+    CONST = 260,                   /* CONST  */
+    VAR = 261,                     /* VAR  */
+    PROCEDURE = 262,               /* PROCEDURE  */
+    CALL = 263,                    /* CALL  */
+    BEGIN_SYM = 264,               /* BEGIN_SYM  */
+    END = 265,                     /* END  */
+    IF = 266,                      /* IF  */
+    THEN = 267,                    /* THEN  */
+    WHILE = 268,                   /* WHILE  */
+    DO = 269,                      /* DO  */
+    ODD = 270,                     /* ODD  */
+    READ = 271,                    /* READ  */
+    WRITE = 272,                   /* WRITE  */
+    ASSIGN = 273,                  /* ASSIGN  */
+    EQ = 274,                      /* EQ  */
+    NE = 275,                      /* NE  */
+    LT = 276,                      /* LT  */
+    LE = 277,                      /* LE  */
+    GT = 278,                      /* GT  */
+    GE = 279,                      /* GE  */
+    PLUS = 280,                    /* PLUS  */
+    MINUS = 281,                   /* MINUS  */
+    TIMES = 282,                   /* TIMES  */
+    SLASH = 283,                   /* SLASH  */
+    LPAREN = 284,                  /* LPAREN  */
+    RPAREN = 285,                  /* RPAREN  */
+    COMMA = 286,                   /* COMMA  */
+    SEMICOLON = 287,               /* SEMICOLON  */
+    PERIOD = 288,                  /* PERIOD  */
+    UMINUS = 289                   /* UMINUS  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 1676 of yacc.c  */
 #line 35 "pl0.y"
 
     int number;
-    char *ident;
-
+    char *ident;    /* intern()返回的句柄，不需释放 */
 
+#line 103 "pl0.tab.h"
 
-/* Line 1676 of yacc.c  */
-#line 93 "pl0.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+
 extern YYSTYPE yylval;
 
 
+int yyparse (void);
+
+
+#endif /* !YY_YY_PL0_TAB_H_INCLUDED  */
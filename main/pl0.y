@@ -8,8 +8,6 @@
 
 extern int yylex();
 extern void yyerror(const char *s);
-extern int line_no;
-extern int col_no;
 extern FILE *yyin;
 
 /* 全局变量 */
@@ -28,13 +26,15 @@ int position(char *id);
 void gen(enum fct f, int l, int a);
 void error(int n);
 void listcode(int from, int to);
+void optimize();
+void compiled();
 void interpret();
 
 %}
 
 %union {
     int number;
-    char *ident;
+    char *ident;    /* intern()返回的句柄，不需释放 */
 }
 
 %token <number> NUMBER
@@ -43,17 +43,36 @@ void interpret();
 %token ASSIGN EQ NE LT LE GT GE PLUS MINUS TIMES SLASH
 %token LPAREN RPAREN COMMA SEMICOLON PERIOD
 
+%type <number> block declaration_list declaration proc_declaration
+%type <number> statement assignment_statement call_statement compound_statement
+%type <number> statement_list if_statement while_statement read_statement
+%type <number> read_list write_statement write_list condition expression term factor
+
 %left PLUS MINUS
 %left TIMES SLASH
 %nonassoc UMINUS
 
+/*
+ * 各非终结符的值：-a时为语法树结点（见ast.c），否则直接生成代码，
+ * 值为0（condition为其条件跳转指令的地址，见gencond()）。
+ */
+
 %%
 
 program:
     block PERIOD
     {
-        gen(OPR, 0, 0);  /* 返回指令 */
+        if (ast_mode) {
+            if (err_count == 0) {
+                astgen($1);
+            }
+            astfree();
+        } else {
+            gen(OPR, 0, 0);  /* 返回指令 */
+        }
         if (err_count == 0) {
+            optimize();
+            compiled();
             printf("\nCompilation successful!\n");
             listcode(0, cx);
             printf("\nStart PL/0\n");
@@ -68,7 +87,9 @@ block:
     {
         dx = 3;           /* 为链接数据预留空间 */
         int jmpaddr = cx;
-        gen(JMP, 0, 0);   /* 产生跳转指令，跳转地址未知 */
+        if (!ast_mode) {
+            gen(JMP, 0, 0);   /* 产生跳转指令，跳转地址未知 */
+        }
         
         if (level > LEVMAX) {
             error(32);    /* 嵌套层次过深 */
@@ -77,30 +98,51 @@ block:
     }
     declaration_list
     {
-        int jmpaddr = $<number>1;
-        code[jmpaddr].a = cx;    /* 回填跳转地址 */
-        /* 如果是过程，记录其入口地址 */
-        int i;
-        for (i = tx; i > 0; i--) {
-            if (table[i].kind == PROCEDURE_SYM && table[i].adr == 0) {
+        if (!ast_mode) {
+            int jmpaddr = $<number>1;
+            code[jmpaddr].a = cx;    /* 回填跳转地址 */
+            /* 如果是过程，记录其入口地址 */
+            int i = curproc();
+            if (i != 0) {
+                /* 回填内层过程中调用本过程的CAL，链由其a域串起 */
+                int k, next;
+                for (k = table[i].val; k >= 0; k = next) {
+                    next = code[k].a;
+                    code[k].a = cx;
+                }
                 table[i].adr = cx;
                 table[i].size = dx;
-                break;
             }
+            gen(INT, 0, dx);         /* 分配空间 */
         }
-        gen(INT, 0, dx);         /* 分配空间 */
     }
     statement
+    {
+        $$ = 0;
+        if (ast_mode) {
+            /* 过程结点在登记过程名时已分配 */
+            int i = curproc();
+            int k = i != 0 ? table[i].adr : mknode(N_PROC, 0, 0, 0, 0);
+            $$ = setproc(k, dx, $2, $4);
+        }
+    }
     ;
 
+/* 值为其中的过程声明链 */
 declaration_list:
     /* empty */
+    {
+        $$ = 0;
+    }
     | declaration_list declaration
+    {
+        $$ = append($1, $2);
+    }
     ;
 
 declaration:
-    const_declaration
-    | var_declaration
+    const_declaration       { $$ = 0; }
+    | var_declaration       { $$ = 0; }
     | proc_declaration
     ;
 
@@ -116,10 +158,9 @@ const_list:
 const_def:
     IDENT EQ NUMBER
     {
-        strcpy(id, $1);
+        id = $1;
         num = $3;
         enter(CONSTANT);
-        free($1);
     }
     ;
 
@@ -130,37 +171,46 @@ var_declaration:
 var_list:
     IDENT
     {
-        strcpy(id, $1);
+        id = $1;
         enter(VARIABLE);
-        free($1);
     }
     | var_list COMMA IDENT
     {
-        strcpy(id, $3);
+        id = $3;
         enter(VARIABLE);
-        free($3);
     }
     ;
 
 proc_declaration:
     PROCEDURE IDENT
     {
-        strcpy(id, $2);
+        id = $2;
         enter(PROCEDURE_SYM);
-        free($2);
+        if (ast_mode) {
+            table[tx].adr = mknode(N_PROC, 0, 0, 0, 0);  /* 入口地址生成时才知道 */
+        }
+        openscope();
         level++;
+        $<number>$ = dx;  /* 保存外层的数据分配索引 */
         dx = 3;  /* 重置数据分配索引 */
     }
     SEMICOLON block SEMICOLON
     {
-        gen(OPR, 0, 0);  /* 过程返回 */
+        if (!ast_mode) {
+            gen(OPR, 0, 0);  /* 过程返回 */
+        }
         level--;
-        /* 不重置tx，保留所有符号在符号表中 */
+        dx = $<number>3;  /* 恢复外层的数据分配索引 */
+        closescope();     /* 弹出过程内登记的符号 */
+        $$ = $5;
     }
     ;
 
 statement:
     /* empty */
+    {
+        $$ = 0;
+    }
     | assignment_statement
     | call_statement
     | compound_statement
@@ -174,14 +224,14 @@ assignment_statement:
     IDENT ASSIGN expression
     {
         int i = position($1);
+        $$ = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != VARIABLE) {
             error(12);  /* 不能给常量或过程赋值 */
         } else {
-            gen(STO, level - table[i].level, table[i].adr);
+            $$ = gennode(STO, level - table[i].level, table[i].adr, $3, 0);
         }
-        free($1);
     }
     ;
 
@@ -189,33 +239,54 @@ call_statement:
     CALL IDENT
     {
         int i = position($2);
+        $$ = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != PROCEDURE_SYM) {
             error(15);  /* 调用非过程标识符 */
+        } else if (!ast_mode && table[i].adr < 0) {
+            /* 内层过程调用外层过程，入口未定，链入待回填的CAL */
+            gen(CAL, level - table[i].level, table[i].val);
+            table[i].val = cx - 1;
         } else {
-            gen(CAL, level - table[i].level, table[i].adr);
+            $$ = gennode(CAL, level - table[i].level, table[i].adr, 0, 0);
         }
-        free($2);
     }
     ;
 
 compound_statement:
     BEGIN_SYM statement_list END
+    {
+        $$ = $2;
+    }
     ;
 
 statement_list:
     statement
+    {
+        $$ = append(0, $1);
+    }
     | statement_list SEMICOLON statement
+    {
+        $$ = append($1, $3);
+    }
     ;
 
 if_statement:
     IF condition THEN statement
     {
-        code[$<number>2].a = cx;  /* 回填跳转地址 */
+        if (ast_mode) {
+            $$ = mknode(N_IF, 0, 0, $2, $4);
+        } else {
+            if ($2 >= 0) {
+                code[$2].a = cx;  /* 回填跳转地址，条件恒成立时没有跳转 */
+            }
+            $$ = 0;
+        }
     }
     ;
 
+/* 循环旋转：JMP到末尾的条件判断，条件成立时跳回循环体，每次迭代只有一次跳转 */
 while_statement:
     WHILE
     {
@@ -223,81 +294,90 @@ while_statement:
     }
     condition DO
     {
-        $<number>$ = $<number>3;  /* 保存JPC地址 */
+        if (!ast_mode) {
+            $<number>$ = savecond($<number>2);  /* 条件代码移到循环末尾 */
+            gen(JMP, 0, 0);                     /* 跳到条件判断，地址未知 */
+        }
     }
     statement
     {
-        gen(JMP, 0, $<number>2);      /* 跳回循环开始 */
-        code[$<number>5].a = cx;      /* 回填条件跳转地址 */
+        if (ast_mode) {
+            $$ = mknode(N_WHILE, 0, 0, $3, $6);
+        } else {
+            code[$<number>2].a = cx;                   /* 回填入口跳转地址 */
+            restorecond($<number>5, $<number>2 + 1);   /* 条件成立时跳回循环体 */
+            $$ = 0;
+        }
     }
     ;
     
 read_statement:
     READ LPAREN read_list RPAREN
+    {
+        $$ = $3;
+    }
     ;
 
 read_list:
     IDENT
     {
         int i = position($1);
+        $$ = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else if (table[i].kind != VARIABLE) {
             error(12);  /* 只能读入变量 */
         } else {
-            gen(OPR, 0, 16);  /* 读操作 */
-            gen(STO, level - table[i].level, table[i].adr);
+            /* 读操作 */
+            $$ = append(0, gennode(STO, level - table[i].level, table[i].adr,
+                                   gennode(OPR, 0, 16, 0, 0), 0));
         }
-        free($1);
     }
     | read_list COMMA IDENT
     {
         int i = position($3);
+        $$ = $1;
         if (i == 0) {
             error(11);
         } else if (table[i].kind != VARIABLE) {
             error(12);
         } else {
-            gen(OPR, 0, 16);
-            gen(STO, level - table[i].level, table[i].adr);
+            $$ = append($1, gennode(STO, level - table[i].level, table[i].adr,
+                                    gennode(OPR, 0, 16, 0, 0), 0));
         }
-        free($3);
     }
     ;
 
 write_statement:
     WRITE LPAREN write_list RPAREN
     {
-        gen(OPR, 0, 15);  /* 输出换行 */
+        $$ = append($3, gennode(OPR, 0, 15, 0, 0));  /* 输出换行 */
     }
     ;
 
 write_list:
     expression
     {
-        gen(OPR, 0, 14);  /* 输出栈顶值 */
+        $$ = append(0, gennode(OPR, 0, 14, $1, 0));  /* 输出栈顶值 */
     }
     | write_list COMMA expression
     {
-        gen(OPR, 0, 14);
+        $$ = append($1, gennode(OPR, 0, 14, $3, 0));
     }
     ;
 
 condition:
     ODD expression
     {
-        gen(OPR, 0, 6);  /* ODD操作 */
-        $<number>$ = cx;
-        gen(JPC, 0, 0);  /* 条件跳转 */
+        $$ = gencond(JOD, $2, 0);  /* ODD不成立则跳转 */
     }
     | expression rel_op expression
     {
-        gen(OPR, 0, $<number>2);  /* 关系运算 */
-        $<number>$ = cx;
-        gen(JPC, 0, 0);           /* 条件跳转 */
+        $$ = gencond(JEQ + $<number>2 - 8, $1, $3);  /* 关系不成立则跳转 */
     }
     ;
 
+/* 关系运算号，与OPR 8~13及JEQ~JLE的顺序一致 */
 rel_op:
     EQ    { $<number>$ = 8; }
     | NE  { $<number>$ = 9; }
@@ -310,17 +390,20 @@ rel_op:
 expression:
     term
     | PLUS term
+    {
+        $$ = $2;
+    }
     | MINUS term %prec UMINUS
     {
-        gen(OPR, 0, 1);  /* 取负 */
+        $$ = gennode(OPR, 0, 1, $2, 0);  /* 取负 */
     }
     | expression PLUS term
     {
-        gen(OPR, 0, 2);  /* 加法 */
+        $$ = gennode(OPR, 0, 2, $1, $3);  /* 加法 */
     }
     | expression MINUS term
     {
-        gen(OPR, 0, 3);  /* 减法 */
+        $$ = gennode(OPR, 0, 3, $1, $3);  /* 减法 */
     }
     ;
 
@@ -328,11 +411,11 @@ term:
     factor
     | term TIMES factor
     {
-        gen(OPR, 0, 4);  /* 乘法 */
+        $$ = gennode(OPR, 0, 4, $1, $3);  /* 乘法 */
     }
     | term SLASH factor
     {
-        gen(OPR, 0, 5);  /* 除法 */
+        $$ = gennode(OPR, 0, 5, $1, $3);  /* 除法 */
     }
     ;
 
@@ -340,22 +423,22 @@ factor:
     IDENT
     {
         int i = position($1);
+        $$ = 0;
         if (i == 0) {
             error(11);  /* 标识符未声明 */
         } else {
             switch (table[i].kind) {
                 case CONSTANT:
-                    gen(LIT, 0, table[i].val);
+                    $$ = gennode(LIT, 0, table[i].val, 0, 0);
                     break;
                 case VARIABLE:
-                    gen(LOD, level - table[i].level, table[i].adr);
+                    $$ = gennode(LOD, level - table[i].level, table[i].adr, 0, 0);
                     break;
                 case PROCEDURE_SYM:
                     error(21);  /* 表达式中不能有过程标识符 */
                     break;
             }
         }
-        free($1);
     }
     | NUMBER
     {
@@ -363,14 +446,19 @@ factor:
             error(30);  /* 数值越界 */
             $1 = 0;
         }
-        gen(LIT, 0, $1);
+        $$ = gennode(LIT, 0, $1, 0, 0);
     }
     | LPAREN expression RPAREN
+    {
+        $$ = $2;
+    }
     ;
 
 %%
 
 void yyerror(const char *s) {
-    fprintf(stderr, "Error: %s at line %d, column %d\n", s, line_no, col_no);
+    int line, col;
+    src_position(src_offset, &line, &col);
+    fprintf(stderr, "Error: %s at line %d, column %d\n", s, line, col);
     err_count++;
 }
\ No newline at end of file
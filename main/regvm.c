@@ -0,0 +1,416 @@
+/* regvm.c - PL/0 ַĴ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * Ĵcode[]Ĵ¼еĵԪs[b + r]
+ * ֱֲַĴţջdʱĴ
+ * ¼С + dԴΪʱʾkst[~x]
+ * ʱԲջͣLIT;ֲLODֻѹָ
+ * ֱдĿļĴ i := i + 1 ֻһ ADD
+ */
+
+/* Ĵָ */
+enum rop {
+    R_MOV,     /* d := x */
+    R_NEG,     /* d := -x */
+    R_ADD,     /* d := x + y */
+    R_SUB,     /* d := x - y */
+    R_MUL,     /* d := x * y */
+    R_DIV,     /* d := x / y */
+    R_ODD,     /* d := x & 1 */
+    R_SHL,     /* d := x << y */
+    R_SHR,     /* d := x / 2^yȡ */
+    R_DVM,     /* d := x / ħλΪkst[~y]kst[~y + 1] */
+    R_EQL,     /* d := x = y */
+    R_NEQ,     /* d := x # y */
+    R_LSS,     /* d := x < y */
+    R_GEQ,     /* d := x >= y */
+    R_GTR,     /* d := x > y */
+    R_LEQ,     /* d := x <= y */
+    R_GET,     /* d := xַyı */
+    R_RED,     /* d */
+    R_SET,     /* yַdı := x */
+    R_WRT,     /* x */
+    R_WRL,     /*  */
+    R_JMP,     /* תd */
+    R_JPC,     /* x = 0 ʱתd */
+    R_JEQ,     /* x = y תdR_JEQ~R_JLEJEQ~JLE˳һ */
+    R_JNE,
+    R_JLT,
+    R_JGE,
+    R_JGT,
+    R_JLE,
+    R_JOD,     /* ODD x Ľyʱתd */
+    R_CAL,     /* dx»¼ַΪb + y */
+    R_RET      /*  */
+};
+
+struct rinstr {
+    enum rop op;
+    int d;
+    int x;
+    int y;
+};
+
+static struct rinstr rcode[CXMAX * 2];  /* Ĵ */
+static int rcx;                         /* Ĵ */
+static int kst[CXMAX];                  /*  */
+static int kx;                          /*  */
+static int rmap[CXMAX];                 /* code[]ַrcode[]ַ */
+
+/* ʱĳջÿָѹһ */
+static int st[CXMAX];
+static int sp;
+static int fs;                          /* ǰ¼С */
+static int label;                       /* һתĿrcodeַ */
+
+#define TEMP(d) (fs + (d))
+
+static void emit(enum rop op, int d, int x, int y) {
+    rcode[rcx].op = op;
+    rcode[rcx].d = d;
+    rcode[rcx].x = x;
+    rcode[rcx].y = y;
+    rcx++;
+}
+
+/* cĲ */
+static int konst(int c) {
+    kst[kx] = c;
+    return ~kx++;
+}
+
+/* ջеk䵽ʱĴ */
+static void spill(int k) {
+    if (st[k] != TEMP(k)) {
+        emit(R_MOV, TEMP(k), st[k], 0);
+        st[k] = TEMP(k);
+    }
+}
+
+/* ȫջ䵽ʱĴתתĿ괦 */
+static void spillall() {
+    int k;
+    for (k = 0; k < sp; k++) {
+        spill(k);
+    }
+}
+
+/* дֲr֮ǰջδȡr䵽ʱĴ */
+static void spillreg(int r) {
+    int k;
+    for (k = 0; k < sp; k++) {
+        if (st[k] == r) {
+            spill(k);
+        }
+    }
+}
+
+/* ָָԭ */
+static enum fct unfuse(enum fct f) {
+    switch (f) {
+        case STC: return LIT;
+        case UPD: return LOD;
+        case JVV: return LOD;
+        case JVC: return LOD;
+        default:  return f;
+    }
+}
+
+/* code[]ΪĴ */
+static void translate() {
+    static char target[CXMAX];
+    struct instruction *i;
+    enum fct f;
+    int k, x, y;
+    
+    memset(target, 0, cx);
+    for (k = 0; k < cx; k++) {
+        f = code[k].f;
+        if (f == JMP || f == JPC || f == CAL || (f >= JEQ && f <= JOD)) {
+            target[code[k].a] = 1;
+        }
+    }
+    
+    rcx = kx = sp = fs = label = 0;
+    for (k = 0; k < cx; k++) {
+        i = &code[k];
+        if (target[k]) {
+            spillall();
+            label = rcx;
+        }
+        rmap[k] = rcx;
+        
+        switch (unfuse(i->f)) {
+            case LIT:
+                st[sp++] = konst(i->a);
+                break;
+                
+            case LOD:
+                if (i->l == 0) {
+                    st[sp++] = i->a;
+                } else {
+                    emit(R_GET, TEMP(sp), i->l, i->a);
+                    st[sp] = TEMP(sp);
+                    sp++;
+                }
+                break;
+                
+            case STO:
+            case STK:
+                x = st[--sp];
+                if (i->l != 0) {
+                    emit(R_SET, i->a, x, i->l);
+                } else {
+                    spillreg(i->a);
+                    /* һָջֵʱֱӸдĿļĴ */
+                    if (x == TEMP(sp) && rcx > label && rcode[rcx - 1].d == x &&
+                        rcode[rcx - 1].op <= R_RED) {
+                        rcode[rcx - 1].d = i->a;
+                    } else {
+                        emit(R_MOV, i->a, x, 0);
+                    }
+                    x = i->a;
+                }
+                if (i->f == STK) {
+                    st[sp++] = x;    /* ͬSTOLOD */
+                }
+                break;
+                
+            case OPR:
+                switch (i->a) {
+                    case 0:
+                        spillall();
+                        emit(R_RET, 0, 0, 0);
+                        break;
+                    case 1:
+                    case 6:
+                        x = st[sp - 1];
+                        emit(i->a == 1 ? R_NEG : R_ODD, TEMP(sp - 1), x, 0);
+                        st[sp - 1] = TEMP(sp - 1);
+                        break;
+                    case 2: case 3: case 4: case 5:
+                    case 8: case 9: case 10: case 11: case 12: case 13:
+                        y = st[--sp];
+                        x = st[sp - 1];
+                        emit(i->a <= 5 ? R_ADD + i->a - 2 : R_EQL + i->a - 8, TEMP(sp - 1), x, y);
+                        st[sp - 1] = TEMP(sp - 1);
+                        break;
+                    case 14:
+                        emit(R_WRT, 0, st[--sp], 0);
+                        break;
+                    case 15:
+                        emit(R_WRL, 0, 0, 0);
+                        break;
+                    case 16:
+                        emit(R_RED, TEMP(sp), 0, 0);
+                        st[sp] = TEMP(sp);
+                        sp++;
+                        break;
+                }
+                break;
+                
+            case SHL:
+            case SHR:
+                x = st[sp - 1];
+                emit(i->f == SHL ? R_SHL : R_SHR, TEMP(sp - 1), x, i->a);
+                st[sp - 1] = TEMP(sp - 1);
+                break;
+                
+            case DVM:
+                x = st[sp - 1];
+                emit(R_DVM, TEMP(sp - 1), x, konst(i->a));
+                konst(i->l);
+                st[sp - 1] = TEMP(sp - 1);
+                break;
+                
+            case CAL:
+                spillall();
+                emit(R_CAL, i->a, i->l, fs + sp);
+                break;
+                
+            case INT:
+                if (i->a < 0) {
+                    sp += i->a;  /* ջ */
+                } else {
+                    fs = i->a;   /*  */
+                }
+                break;
+                
+            case JMP:
+                spillall();
+                emit(R_JMP, i->a, 0, 0);
+                break;
+                
+            case JPC:
+                x = st[--sp];
+                spillall();
+                emit(R_JPC, i->a, x, 0);
+                break;
+                
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+                y = st[--sp];
+                x = st[--sp];
+                spillall();
+                emit(R_JEQ + i->f - JEQ, i->a, x, y);
+                break;
+                
+            case JOD:
+                x = st[--sp];
+                spillall();
+                emit(R_JOD, i->a, x, i->l);
+                break;
+                
+            default:
+                break;
+        }
+    }
+    
+    /* תõַΪrcodeַ */
+    for (k = 0; k < rcx; k++) {
+        if (rcode[k].op >= R_JMP && rcode[k].op <= R_CAL) {
+            rcode[k].d = rmap[rcode[k].d];
+        }
+    }
+}
+
+/* Ĵ¼display÷ͬrun_switch() */
+void run_reg() {
+    int b = 1;               /* ַĴ */
+    int lev = 0;             /* ǰ */
+    int display[LEVMAX + 1]; /* ¼ַ */
+    int *s = vm_stack;       /* ջ */
+    struct rinstr *ri;       /* ǰָ */
+    long long n = 0;         /* ɼ */
+    int nb, ra;
+    
+    translate();
+    if (vm_stats) {
+        printf("Register code: %d instructions (stack code %d)\n", rcx, cx);
+    }
+    
+#define R(r)  s[b + (r)]
+#define RK(o) ((o) >= 0 ? s[b + (o)] : kst[~(o)])
+    
+    display[0] = b;
+    ri = rcode;
+    for (;;) {
+        n++;
+        switch (ri->op) {
+            case R_MOV: R(ri->d) = RK(ri->x); break;
+            case R_NEG: R(ri->d) = -RK(ri->x); break;
+            case R_ADD: R(ri->d) = RK(ri->x) + RK(ri->y); break;
+            case R_SUB: R(ri->d) = RK(ri->x) - RK(ri->y); break;
+            case R_MUL: R(ri->d) = RK(ri->x) * RK(ri->y); break;
+            case R_DIV: R(ri->d) = RK(ri->x) / RK(ri->y); break;
+            case R_ODD: R(ri->d) = RK(ri->x) & 1; break;
+            case R_SHL: R(ri->d) = SHLK(RK(ri->x), ri->y); break;
+            case R_SHR: R(ri->d) = SHRK(RK(ri->x), ri->y); break;
+            case R_DVM: R(ri->d) = DIVM(RK(ri->x), kst[~ri->y], kst[~ri->y + 1]); break;
+            case R_EQL: R(ri->d) = RK(ri->x) == RK(ri->y); break;
+            case R_NEQ: R(ri->d) = RK(ri->x) != RK(ri->y); break;
+            case R_LSS: R(ri->d) = RK(ri->x) < RK(ri->y); break;
+            case R_GEQ: R(ri->d) = RK(ri->x) >= RK(ri->y); break;
+            case R_GTR: R(ri->d) = RK(ri->x) > RK(ri->y); break;
+            case R_LEQ: R(ri->d) = RK(ri->x) <= RK(ri->y); break;
+            
+            case R_GET:
+                R(ri->d) = s[display[lev - ri->x] + ri->y];
+                break;
+            case R_SET:
+                s[display[lev - ri->y] + ri->d] = RK(ri->x);
+                break;
+            
+            case R_RED:
+                R(ri->d) = vm_read();
+                break;
+            case R_WRT:
+                vm_write(RK(ri->x));
+                break;
+            case R_WRL:
+                vm_writeln();
+                break;
+            
+            case R_JMP:
+                ri = rcode + ri->d;
+                continue;
+            case R_JPC:
+                if (RK(ri->x) == 0) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JEQ:
+                if (!(RK(ri->x) == RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JNE:
+                if (!(RK(ri->x) != RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JLT:
+                if (!(RK(ri->x) < RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JGE:
+                if (!(RK(ri->x) >= RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JGT:
+                if (!(RK(ri->x) > RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JLE:
+                if (!(RK(ri->x) <= RK(ri->y))) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            case R_JOD:
+                if ((RK(ri->x) & 1) == ri->y) {
+                    ri = rcode + ri->d;
+                    continue;
+                }
+                break;
+            
+            case R_CAL:
+                nb = b + ri->y;
+                lev = lev - ri->x + 1;
+                s[nb] = display[lev];
+                s[nb + 1] = b;
+                s[nb + 2] = ri - rcode + 1;
+                b = nb;
+                display[lev] = b;
+                ri = rcode + ri->d;
+                continue;
+            case R_RET:
+                display[lev] = s[b];
+                ra = s[b + 2];
+                b = s[b + 1];
+                if (ra == 0) {
+                    vm_dispatch = n;
+                    return;
+                }
+                ri = rcode + ra;
+                lev = lev - 1 + ri[-1].x;
+                continue;
+        }
+        ri++;
+    }
+    
+#undef R
+#undef RK
+}
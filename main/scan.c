@@ -0,0 +1,318 @@
+/* scan.c - PL/0 дʷ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "pl0.h"
+#include "pl0.tab.h"
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * pl0.lɵlex.yy.cӿͬsrc_opensrc_buffersrc_closeyylex
+ * yylvalsrc_offsetʱѡһӡ
+ * Դļmmapӳ䣬Ҳsrc_buffer()ֱӸڴе
+ * Դ򣬶ԭɨ裬Ҳ޸ġǺֻԴеһ
+ * (λ, )־͵תʶintern_span()פΪָ״
+ * ִľԴڱǰ뱣Ч
+ * ɨ账ĩβ֮Ҫա
+ * հעSSE2-mavx2ʱAVX2һαȽһ飬һ
+ * ĩβֽڴհʱҵһǿհֽڣעʱ'}'
+ * ؼɢУȡĸڶĸĩĸСд
+ *  len + c0 + 2*c1 + 15*cn ȡ4λ13ؼָռһۣ
+ * ٱȽһμȷ
+ */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+typedef __m256i vec;
+#define VSIZE        32
+#define VLOAD(p)     _mm256_loadu_si256((const __m256i *)(p))
+#define VSPLAT(c)    _mm256_set1_epi8(c)
+#define VEQ(x, y)    _mm256_cmpeq_epi8(x, y)
+#define VOR(x, y)    _mm256_or_si256(x, y)
+#define VMASK(x)     (unsigned)_mm256_movemask_epi8(x)
+#define VALL         0xffffffffu
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+typedef __m128i vec;
+#define VSIZE        16
+#define VLOAD(p)     _mm_loadu_si128((const __m128i *)(p))
+#define VSPLAT(c)    _mm_set1_epi8(c)
+#define VEQ(x, y)    _mm_cmpeq_epi8(x, y)
+#define VOR(x, y)    _mm_or_si128(x, y)
+#define VMASK(x)     (unsigned)_mm_movemask_epi8(x)
+#define VALL         0xffffu
+#else
+#define VSIZE        1
+#endif
+
+FILE *yyin;
+
+static const char *src;      /* Դ */
+static const char *cur;      /* ɨλ */
+static const char *end;      /* Դĩβ */
+static char *loaded;         /* ޷ӳʱԴ */
+static void *mapped;         /* ӳԴļ */
+static size_t mapsize;
+
+/* ؼɢб±keyword() */
+static struct {
+    char *name;
+    int token;
+} kwtab[16] = {
+    {"END", END}, {"IF", IF}, {"CONST", CONST}, {"BEGIN", BEGIN_SYM},
+    {NULL, 0}, {"DO", DO}, {"ODD", ODD}, {"WHILE", WHILE},
+    {"PROCEDURE", PROCEDURE}, {"VAR", VAR}, {"THEN", THEN}, {"WRITE", WRITE},
+    {"READ", READ}, {"CALL", CALL}, {NULL, 0}, {NULL, 0}
+};
+
+/* ַ */
+#define C_LETTER 1
+#define C_DIGIT  2
+static unsigned char ctype[256];
+
+/* p[0..n)ɨ */
+static void setsource(const char *p, long n) {
+    int k;
+    
+    src = cur = p;
+    end = p + n;
+    src_text(p, n);
+    for (k = 'a'; k <= 'z'; k++) {
+        ctype[k] = ctype[k - 'a' + 'A'] = C_LETTER;
+    }
+    for (k = '0'; k <= '9'; k++) {
+        ctype[k] = C_DIGIT;
+    }
+}
+
+/* ӳʱyyinԴļ */
+static void load() {
+    size_t size = 65536, n = 0, k;
+    
+    if (!yyin) {
+        yyin = stdin;
+    }
+    loaded = malloc(size);
+    while (loaded && (k = fread(loaded + n, 1, size - n, yyin)) > 0) {
+        n += k;
+        if (n == size) {
+            size *= 2;
+            loaded = realloc(loaded, size);
+        }
+    }
+    if (!loaded) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    setsource(loaded, n);
+}
+
+/* Դļͨļӳ䣬ʧܷ0 */
+int src_open(const char *name) {
+#if defined(__unix__)
+    struct stat st;
+    int fd = open(name, O_RDONLY);
+    
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            mapsize = st.st_size;
+            madvise(mapped, mapsize, MADV_SEQUENTIAL);
+            close(fd);
+            setsource(mapped, mapsize);
+            return 1;
+        }
+        mapped = NULL;
+    }
+    close(fd);
+#endif
+    yyin = fopen(name, "r");
+    if (!yyin) {
+        return 0;
+    }
+    load();
+    return 1;
+}
+
+/* ֱɨڴеԴp[0..n)ǰp뱣Ч */
+void src_buffer(const char *p, long n) {
+    setsource(p, n);
+}
+
+/* ͷԴ */
+void src_close() {
+#if defined(__unix__)
+    if (mapped) {
+        munmap(mapped, mapsize);
+        mapped = NULL;
+    }
+#endif
+    if (yyin) {
+        fclose(yyin);
+        yyin = NULL;
+    }
+    free(loaded);
+    loaded = NULL;
+    src = cur = end = NULL;
+}
+
+/* pʼĿհַ */
+static int skipspace(const char *p) {
+    const char *q = p;
+#if VSIZE > 1
+    vec sp = VSPLAT(' '), tab = VSPLAT('\t'), cr = VSPLAT('\r'), nl = VSPLAT('\n');
+    for (; end - q >= VSIZE; q += VSIZE) {
+        vec v = VLOAD(q);
+        unsigned m = VMASK(VOR(VOR(VEQ(v, sp), VEQ(v, tab)), VOR(VEQ(v, cr), VEQ(v, nl))));
+        if (m != VALL) {
+            return q - p + __builtin_ctz(~m);
+        }
+    }
+#endif
+    while (q < end && (*q == ' ' || *q == '\t' || *q == '\r' || *q == '\n')) {
+        q++;
+    }
+    return q - p;
+}
+
+/* pʼ'}'ҲNULL */
+static const char *findbrace(const char *p) {
+#if VSIZE > 1
+    vec rb = VSPLAT('}');
+    for (; end - p >= VSIZE; p += VSIZE) {
+        unsigned m = VMASK(VEQ(VLOAD(p), rb));
+        if (m != 0) {
+            return p + __builtin_ctz(m);
+        }
+    }
+#endif
+    return memchr(p, '}', end - p);
+}
+
+/* ʶp[0..len)ĹؼּǺţǹؼַ0 */
+static int keyword(const char *p, int len) {
+    int h, k;
+    char *w;
+    
+    if (len < 2 || len > 9) {
+        return 0;
+    }
+    h = (len + (p[0] | 0x20) + 2 * (p[1] | 0x20) + 15 * (p[len - 1] | 0x20)) & 15;
+    w = kwtab[h].name;
+    if (w == NULL) {
+        return 0;
+    }
+    for (k = 0; k < len; k++) {
+        if ((p[k] & ~0x20) != w[k]) {
+            return 0;
+        }
+    }
+    return w[len] == '\0' ? kwtab[h].token : 0;
+}
+
+/* ȡһǺţļʱ0 */
+int yylex() {
+    const char *p, *q;
+    int len, tok, line, col;
+    long v;
+    
+    if (src == NULL) {
+        load();
+    }
+    
+    for (;;) {
+        cur += skipspace(cur);
+        if (cur >= end) {
+            src_offset = end - src;
+            return 0;
+        }
+        if (*cur != '{' || (q = findbrace(cur + 1)) == NULL) {
+            break;
+        }
+        cur = q + 1;    /* ע */
+    }
+    
+    p = cur;
+    if (ctype[(unsigned char)*p] == C_LETTER) {
+        for (q = p + 1; q < end && ctype[(unsigned char)*q] != 0; q++)
+            ;
+        len = q - p;
+        cur = q;
+        src_offset = cur - src;
+        tok = keyword(p, len);
+        if (tok != 0) {
+            return tok;
+        }
+        yylval.ident = intern_span(p, len);
+        return IDENT;
+    }
+    if (ctype[(unsigned char)*p] == C_DIGIT) {
+        v = 0;
+        for (q = p; q < end && ctype[(unsigned char)*q] == C_DIGIT; q++) {
+            if (v <= INT_MAX) {
+                v = v * 10 + (*q - '0');
+            }
+        }
+        cur = q;
+        src_offset = cur - src;
+        yylval.number = v > INT_MAX ? INT_MAX : (int)v;
+        return NUMBER;
+    }
+    
+    cur++;
+    tok = 0;
+    switch (*p) {
+        case ':':
+            if (cur < end && *cur == '=') {
+                cur++;
+                tok = ASSIGN;
+            }
+            break;
+        case '<':
+            if (cur < end && *cur == '=') {
+                cur++;
+                tok = LE;
+            } else {
+                tok = LT;
+            }
+            break;
+        case '>':
+            if (cur < end && *cur == '=') {
+                cur++;
+                tok = GE;
+            } else {
+                tok = GT;
+            }
+            break;
+        case '=': tok = EQ; break;
+        case '#': tok = NE; break;
+        case '+': tok = PLUS; break;
+        case '-': tok = MINUS; break;
+        case '*': tok = TIMES; break;
+        case '/': tok = SLASH; break;
+        case '(': tok = LPAREN; break;
+        case ')': tok = RPAREN; break;
+        case ',': tok = COMMA; break;
+        case ';': tok = SEMICOLON; break;
+        case '.': tok = PERIOD; break;
+    }
+    src_offset = cur - src;
+    if (tok != 0) {
+        return tok;
+    }
+    src_position(src_offset, &line, &col);
+    printf("Error: Unexpected character '%c' at line %d, column %d\n",
+           *p, line, col);
+    return (unsigned char)*p;
+}
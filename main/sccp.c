@@ -0,0 +1,372 @@
+/* sccp.c - PL/0  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "pl0.h"
+
+/*
+ * ÿɴ̵Ŀͼϡֵδ
+ * 仯֣ÿڼ¼̷ʵĸĸֵڴ
+ * 仯ģֲûгֵɵ߾ڿ
+ * ڵĸֵģָջҲǸֵβת
+ * ǳʱֻһ߿ִУֻؿִеı߰ѳڸֵ
+ * ̿飬ֱٱ仯CALغ󣬱ܸ̿дıΪ仯ġ
+ * ģһִеĿ飺ֵΪLODидΪһLIT
+ * AMAXʱģǳתΪJMPɾȥ
+ * ִеĿɾȥֻĩβOPR 0
+ * ߽紦ջΪգһֵǿ޸õָ
+ */
+
+#define STATEMAX (1 << 21)   /* ÿ¼ĸֵ */
+
+enum { T_UNDEF, T_CONST, T_VARY };
+
+struct cval {
+    int kind;
+    int c;
+};
+
+/* ջϵֵpureʱ[start, end]ǡǼָ */
+struct slot {
+    struct cval v;
+    int start, end;
+    int pure;
+};
+
+int sccp_consts;             /* дΪLITֵ */
+int sccp_branches;           /* ȥת */
+
+static struct proc *cur;     /* ǰ */
+static int nv;               /* ǰ̵ı */
+static struct slot stk[CXMAX];
+static int sp;
+
+/* ֵĽ */
+static struct cval meet(struct cval x, struct cval y) {
+    if (x.kind == T_UNDEF) {
+        return y;
+    }
+    if (y.kind == T_UNDEF || (x.kind == T_CONST && y.kind == T_CONST && x.c == y.c)) {
+        return x;
+    }
+    x.kind = T_VARY;
+    return x;
+}
+
+/* OPR axyһԪֻxintΪ0ʱΪ仯 */
+static struct cval compute(int a, struct cval x, struct cval y) {
+    struct cval r;
+    long long v;
+    
+    r.kind = x.kind > y.kind ? x.kind : y.kind;
+    r.c = 0;
+    if (a == 1 || a == 6) {
+        r.kind = x.kind;
+    }
+    if (r.kind != T_CONST) {
+        return r;
+    }
+    switch (a) {
+        case 1:  v = -(long long)x.c; break;
+        case 2:  v = (long long)x.c + y.c; break;
+        case 3:  v = (long long)x.c - y.c; break;
+        case 4:  v = (long long)x.c * y.c; break;
+        case 5:  v = y.c != 0 ? (long long)x.c / y.c : (long long)INT_MAX + 1; break;
+        case 6:  v = x.c % 2 != 0; break;
+        case 8:  v = x.c == y.c; break;
+        case 9:  v = x.c != y.c; break;
+        case 10: v = x.c < y.c; break;
+        case 11: v = x.c >= y.c; break;
+        case 12: v = x.c > y.c; break;
+        default: v = x.c <= y.c; break;
+    }
+    if (v < INT_MIN || v > INT_MAX) {
+        r.kind = T_VARY;
+    } else {
+        r.c = (int)v;
+    }
+    return r;
+}
+
+/* תfڲxyǷת */
+static int taken(struct instruction *i, struct cval x, struct cval y) {
+    switch (i->f) {
+        case JPC: return x.c == 0;
+        case JOD: return (x.c % 2 != 0) == i->l;
+        case JEQ: return x.c != y.c;
+        case JNE: return x.c == y.c;
+        case JLT: return x.c >= y.c;
+        case JGE: return x.c < y.c;
+        case JGT: return x.c <= y.c;
+        default:  return x.c > y.c;
+    }
+}
+
+static void push(struct cval v, int k) {
+    stk[sp].v = v;
+    stk[sp].start = stk[sp].end = k;
+    stk[sp].pure = 1;
+    sp++;
+}
+
+/* ջnֵָܷkϲΪһ */
+static int joinable(int n, int k) {
+    int j;
+    
+    for (j = sp - n; j < sp; j++) {
+        if (!stk[j].pure || stk[j].end + 1 != (j + 1 < sp ? stk[j + 1].start : k)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* һֵ۵ָrewriteʱѳидΪLIT */
+static struct cval use(int rewrite) {
+    struct slot *s = &stk[--sp];
+    int k;
+    
+    if (rewrite && s->pure && s->v.kind == T_CONST && (s->end > s->start || code[s->end].f != LIT)
+        && s->v.c >= -AMAX && s->v.c <= AMAX) {
+        for (k = s->start; k < s->end; k++) {
+            discard(k);
+        }
+        code[s->end].f = LIT;
+        code[s->end].l = 0;
+        code[s->end].a = s->v.c;
+        sccp_consts++;
+    }
+    return s->v;
+}
+
+/*
+ * stΪڸֵģbstΪڸֵؿִеĳߣ1Ϊ˳
+ * ִУ2Ϊת״ܷʱ-1rewriteʱͬʱд롣
+ */
+static int simulate(int b, struct cval *st, int rewrite) {
+    struct instruction *i;
+    struct cval x, y, vary = {T_VARY, 0};
+    int k, j, n, v;
+    
+    sp = 0;
+    for (k = blocks[b].start; k < blocks[b].end; k++) {
+        i = &code[k];
+        switch (i->f) {
+            case LIT:
+                x.kind = T_CONST;
+                x.c = i->a;
+                push(x, k);
+                break;
+            case LOD:
+                push(st[varno(varof(cur, k))], k);
+                break;
+            case STO:
+            case STK:
+                if (sp < 1) {
+                    return -1;
+                }
+                v = varno(varof(cur, k));
+                if (i->f == STK) {
+                    st[v] = stk[sp - 1].v;
+                    stk[sp - 1].pure = 0;    /* ջϵֵٸд */
+                } else {
+                    st[v] = use(rewrite);
+                }
+                break;
+            case CAL:
+                if (procat[i->a] < 0) {
+                    return -1;
+                }
+                for (j = 0; j < nv; j++) {
+                    if (inset(&procs[procat[i->a]].mods, varids[j])) {
+                        st[j] = vary;
+                    }
+                }
+                break;
+            case INT:
+                if (i->a >= 0) {
+                    if (k != cur->entry) {
+                        return -1;
+                    }
+                } else {
+                    for (n = -i->a; n > 0; n--) {
+                        if (sp < 1) {
+                            return -1;
+                        }
+                        use(rewrite);
+                    }
+                }
+                break;
+            case OPR:
+                if (i->a == 0) {
+                    return sp == 0 ? 0 : -1;
+                } else if (i->a == 15) {
+                    break;
+                } else if (i->a == 16) {
+                    push(vary, k);
+                } else if (i->a == 14) {
+                    if (sp < 1) {
+                        return -1;
+                    }
+                    use(rewrite);
+                } else if (i->a == 1 || i->a == 6) {
+                    if (sp < 1) {
+                        return -1;
+                    }
+                    x = compute(i->a, stk[sp - 1].v, vary);
+                    if (x.kind == T_CONST && joinable(1, k)) {
+                        stk[sp - 1].v = x;
+                        stk[sp - 1].end = k;
+                    } else {
+                        use(rewrite);
+                        push(x, k);
+                        stk[sp - 1].pure = 0;
+                    }
+                } else if ((i->a >= 2 && i->a <= 5) || (i->a >= 8 && i->a <= 13)) {
+                    if (sp < 2) {
+                        return -1;
+                    }
+                    x = compute(i->a, stk[sp - 2].v, stk[sp - 1].v);
+                    if (x.kind == T_CONST && joinable(2, k)) {
+                        sp--;
+                        stk[sp - 1].v = x;
+                        stk[sp - 1].end = k;
+                    } else {
+                        use(rewrite);
+                        use(rewrite);
+                        push(x, k);
+                        stk[sp - 1].pure = 0;
+                    }
+                } else {
+                    return -1;
+                }
+                break;
+            case JMP:
+                return sp == 0 ? 2 : -1;
+            case JPC:
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+            case JOD:
+                n = (i->f == JPC || i->f == JOD) ? 1 : 2;
+                if (sp != n) {
+                    return -1;
+                }
+                x = stk[0].v;
+                y = n == 2 ? stk[1].v : vary;
+                if (x.kind == T_CONST && (n == 1 || y.kind == T_CONST)) {
+                    j = taken(i, x, y);
+                    if (rewrite && joinable(n, k)) {
+                        /* жûиãһɾȥ */
+                        for (v = stk[0].start; v < k; v++) {
+                            discard(v);
+                        }
+                        if (j) {
+                            i->f = JMP;
+                            i->l = 0;
+                        } else {
+                            discard(k);
+                        }
+                        sccp_branches++;
+                    }
+                    sp = 0;
+                    return j ? 2 : 1;
+                }
+                while (sp > 0) {
+                    use(rewrite);
+                }
+                return 3;
+            default:
+                return -1;
+        }
+    }
+    return sp == 0 ? 1 : -1;
+}
+
+/* Թp */
+static void sccpproc(struct proc *p) {
+    struct cval *in, *st;
+    char *exec, *queued;
+    int *work, nw = 0;
+    int nb, b, e, s, j, mask, changed;
+    
+    cur = p;
+    nb = buildblocks(p);
+    nv = numbervars(p);
+    if (nb < 0 || nv < 0 || (long long)nb * (nv + 1) > STATEMAX) {
+        return;
+    }
+    in = calloc((long long)nb * nv + 1, sizeof(struct cval));
+    st = malloc((nv + 1) * sizeof(struct cval));
+    exec = calloc(nb, 1);
+    queued = calloc(nb, 1);
+    work = malloc(nb * sizeof(int));
+    if (!in || !st || !exec || !queued || !work) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (j = 0; j < nv; j++) {
+        in[j].kind = T_VARY;
+    }
+    exec[0] = queued[0] = 1;
+    work[nw++] = 0;
+    while (nw > 0) {
+        b = work[--nw];
+        queued[b] = 0;
+        memcpy(st, in + (long long)b * nv, nv * sizeof(struct cval));
+        mask = simulate(b, st, 0);
+        if (mask < 0) {
+            goto done;
+        }
+        for (e = 0; e < 2; e++) {
+            s = blocks[b].succ[e];
+            if (!(mask & (1 << e)) || s < 0) {
+                continue;
+            }
+            changed = !exec[s];
+            exec[s] = 1;
+            for (j = 0; j < nv; j++) {
+                struct cval *t = &in[(long long)s * nv + j];
+                struct cval m = meet(*t, st[j]);
+                if (m.kind != t->kind || m.c != t->c) {
+                    *t = m;
+                    changed = 1;
+                }
+            }
+            if (changed && !queued[s]) {
+                queued[s] = 1;
+                work[nw++] = s;
+            }
+        }
+    }
+    for (b = 0; b < nb; b++) {
+        if (exec[b]) {
+            memcpy(st, in + (long long)b * nv, nv * sizeof(struct cval));
+            simulate(b, st, 1);
+        } else {
+            for (j = blocks[b].start; j < blocks[b].end; j++) {
+                if (j != p->end) {
+                    discard(j);
+                }
+            }
+        }
+    }
+done:
+    free(in);
+    free(st);
+    free(exec);
+    free(queued);
+    free(work);
+}
+
+/* ɾȥָ */
+int sccp() {
+    int j;
+    
+    sccp_consts = sccp_branches = 0;
+    findprocs();
+    for (j = 0; j < nprocs; j++) {
+        sccpproc(&procs[j]);
+    }
+    return compact();
+}
@@ -0,0 +1,112 @@
+/* stack.c - PL/0 ʱջ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pl0.h"
+
+int vm_stacksize = 1 << 20;   /* ջ */
+int *vm_stack;                /* ջ */
+
+#if defined(__unix__)
+
+#include <setjmp.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * ջmmapʼֻǰSTACKSIZEֵҳֱ
+ * ޶ǲɷʵҳһػҳԽѿŲʱ
+ * SIGSEGVѿŲּӱ󷵻أִָУ
+ * ػҳΪջstack_run()˸ִѹջʱ
+ * Ҫ߽顣
+ */
+
+static char *base;            /*  */
+static size_t committed;      /* ѿŵֽ */
+static size_t limit;          /* ֽҳ룩 */
+static size_t reserved;       /* ֽػҳ */
+static sigjmp_buf overflow;
+static char altstack[1 << 16];   /* źŴõջ */
+
+static void onsegv(int sig, siginfo_t *info, void *ctx) {
+    char *addr = (char *)info->si_addr;
+    size_t need;
+    
+    if (addr < base || addr >= base + reserved) {
+        /* ջĬϷʽ */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+    if (addr >= base + limit) {
+        siglongjmp(overflow, 1);
+    }
+    need = committed * 2;
+    while (base + need <= addr) {
+        need *= 2;
+    }
+    if (need > limit) {
+        need = limit;
+    }
+    mprotect(base + committed, need - committed, PROT_READ | PROT_WRITE);
+    committed = need;
+}
+
+/* ջִrunջʱ-1 */
+int stack_run(void (*run)()) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    struct sigaction sa, old;
+    stack_t ss;
+    int ret = 0;
+    
+    limit = ((size_t)vm_stacksize * sizeof(int) + page - 1) / page * page;
+    reserved = limit + page;
+    base = mmap(NULL, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        printf("Cannot allocate runtime stack\n");
+        return -1;
+    }
+    committed = (STACKSIZE * sizeof(int) + page - 1) / page * page;
+    if (committed > limit) {
+        committed = limit;
+    }
+    mprotect(base, committed, PROT_READ | PROT_WRITE);
+    vm_stack = (int *)base;
+    
+    ss.ss_sp = altstack;
+    ss.ss_size = sizeof(altstack);
+    ss.ss_flags = 0;
+    sigaltstack(&ss, NULL);
+    sa.sa_sigaction = onsegv;
+    sa.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_NODEFER;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGSEGV, &sa, &old);
+    
+    if (sigsetjmp(overflow, 1) == 0) {
+        run();
+    } else {
+        ret = -1;
+    }
+    
+    sigaction(SIGSEGV, &old, NULL);
+    munmap(base, reserved);
+    vm_stack = NULL;
+    return ret;
+}
+
+#else
+
+/* ƽ̨һη䵽ޣ */
+int stack_run(void (*run)()) {
+    vm_stack = calloc(vm_stacksize, sizeof(int));
+    if (vm_stack == NULL) {
+        printf("Cannot allocate runtime stack\n");
+        return -1;
+    }
+    run();
+    free(vm_stack);
+    vm_stack = NULL;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,327 @@
+/* tier.c - PL/0 ֲִ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * 0ǴĽԻĿ͹ڼĳ̵
+ * ѭĻĿﵽֵʱ̼ʱΪ룺
+ * ڱʱ֮ĵֱӽ룻ѭʱǰ¼
+ * ӻĿ괦תִУOSR㹲s[]display
+ * תʱֻ轻tbͲΡûбȵĴ벻ᱻ롣
+ */
+
+int tier_threshold = 1000;        /* ȵֵ */
+struct vmregs tier_regs;          /* tier_call()غtb */
+
+static int *s;                    /* ջ */
+static int display[LEVMAX + 1];   /* ¼ַ */
+static int hot[CXMAX];            /* ִм */
+static int entry[CXMAX];          /* ָڹ̵ڣ-1ʾκι */
+static int jitok;                 /* ʱǷ */
+static int ncompiled, nosr;       /* ͳ */
+static long long ndispatch;
+
+/* ̵Ĵ䣺ΪJMPĿ͸CALĿ꣬һOPR 0Ϊֹ */
+static void findentries() {
+    int k, e;
+    
+    memset(entry, -1, sizeof(entry));
+    for (e = 0; e < cx; e++) {
+        if (!(e == code[0].a || (code[e].f == INT && hot[e] < 0))) {
+            continue;
+        }
+        for (k = e; k < cx; k++) {
+            entry[k] = e;
+            if (code[k].f == OPR && code[k].a == 0) {
+                break;
+            }
+        }
+    }
+}
+
+/* ΪeḶ́ɹ1 */
+static int compileproc(int e) {
+    int k;
+    
+    if (!jitok) {
+        return 0;
+    }
+    if (jit_compiled(e)) {
+        return 1;
+    }
+    for (k = e; code[k].f != OPR || code[k].a != 0; k++) {
+    }
+    jit_compile(e, k);
+    ncompiled++;
+    if (vm_stats) {
+        vm_flush();
+        printf("Tier: compiled %d..%d\n", e, k);
+    }
+    return 1;
+}
+
+/* ִУֱڵĻ¼أrΪ뷵ʱļĴ */
+static void interp(int p, struct vmregs *r) {
+    int t = r->t;
+    int b = r->b;
+    int lev = r->lev;
+    int depth = 0;   /* ڻ¼ĵ */
+    int cur;
+    struct instruction i;
+    
+/* תĿʱת */
+#define BACKEDGE() \
+    if (p <= cur && entry[p] >= 0 && ++hot[p] == tier_threshold && compileproc(entry[p])) { \
+        goto osr; \
+    }
+    
+    for (;;) {
+        cur = p;
+        i = code[p++];
+        ndispatch++;
+        
+        switch (i.f) {
+            case LIT:
+                s[++t] = i.a;
+                break;
+                
+            case OPR:
+                switch (i.a) {
+                    case 0:
+                        t = b - 1;
+                        display[lev] = s[t + 1];
+                        p = s[t + 3];
+                        b = s[t + 2];
+                        if (depth == 0) {
+                            r->t = t;
+                            r->b = b;
+                            return;
+                        }
+                        depth--;
+                        lev = lev - 1 + code[p - 1].l;
+                        break;
+                    case 1:
+                        s[t] = -s[t];
+                        break;
+                    case 2:
+                        t--;
+                        s[t] = s[t] + s[t + 1];
+                        break;
+                    case 3:
+                        t--;
+                        s[t] = s[t] - s[t + 1];
+                        break;
+                    case 4:
+                        t--;
+                        s[t] = s[t] * s[t + 1];
+                        break;
+                    case 5:
+                        t--;
+                        s[t] = s[t] / s[t + 1];
+                        break;
+                    case 6:
+                        s[t] = s[t] & 1;
+                        break;
+                    case 8:
+                        t--;
+                        s[t] = (s[t] == s[t + 1]);
+                        break;
+                    case 9:
+                        t--;
+                        s[t] = (s[t] != s[t + 1]);
+                        break;
+                    case 10:
+                        t--;
+                        s[t] = (s[t] < s[t + 1]);
+                        break;
+                    case 11:
+                        t--;
+                        s[t] = (s[t] >= s[t + 1]);
+                        break;
+                    case 12:
+                        t--;
+                        s[t] = (s[t] > s[t + 1]);
+                        break;
+                    case 13:
+                        t--;
+                        s[t] = (s[t] <= s[t + 1]);
+                        break;
+                    case 14:
+                        vm_write(s[t]);
+                        t--;
+                        break;
+                    case 15:
+                        vm_writeln();
+                        break;
+                    case 16:
+                        t++;
+                        s[t] = vm_read();
+                        break;
+                }
+                break;
+                
+            case LOD:
+                t++;
+                s[t] = s[display[lev - i.l] + i.a];
+                break;
+                
+            case STO:
+                s[display[lev - i.l] + i.a] = s[t];
+                t--;
+                break;
+                
+            case CAL:
+                lev = lev - i.l + 1;
+                s[t + 1] = display[lev];
+                s[t + 2] = b;
+                s[t + 3] = p;
+                b = t + 1;
+                display[lev] = b;
+                if (++hot[i.a] >= tier_threshold && compileproc(i.a)) {
+                    /* ѱ룬ֱִл */
+                    struct vmregs callee;
+                    callee.t = t;
+                    callee.b = b;
+                    callee.lev = lev;
+                    jit_enter(i.a, s, display, &callee);
+                    t = callee.t;
+                    b = callee.b;
+                    lev = lev - 1 + i.l;
+                } else {
+                    depth++;
+                    p = i.a;
+                }
+                break;
+                
+            case INT:
+                t += i.a;
+                break;
+                
+            case JMP:
+                p = i.a;
+                BACKEDGE();
+                break;
+                
+            case JPC:
+                if (s[t] == 0) {
+                    p = i.a;
+                }
+                t--;
+                BACKEDGE();
+                break;
+                
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+                t -= 2;
+                if (!(i.f == JEQ ? s[t + 1] == s[t + 2] :
+                      i.f == JNE ? s[t + 1] != s[t + 2] :
+                      i.f == JLT ? s[t + 1] < s[t + 2] :
+                      i.f == JGE ? s[t + 1] >= s[t + 2] :
+                      i.f == JGT ? s[t + 1] > s[t + 2] : s[t + 1] <= s[t + 2])) {
+                    p = i.a;
+                }
+                BACKEDGE();
+                break;
+                
+            case JOD:
+                if ((s[t] & 1) == i.l) {
+                    p = i.a;
+                }
+                t--;
+                BACKEDGE();
+                break;
+                
+            case STK:
+                s[display[lev - i.l] + i.a] = s[t];
+                break;
+                
+            case SHL:
+                s[t] = SHLK(s[t], i.a);
+                break;
+                
+            case SHR:
+                s[t] = SHRK(s[t], i.a);
+                break;
+                
+            case DVM:
+                s[t] = DIVM(s[t], i.a, i.l);
+                break;
+                
+            case STC:
+                /* ָڱ㰴ԭִָУָȻ */
+                s[++t] = i.a;
+                break;
+                
+            case UPD: case JVV: case JVC:
+                t++;
+                s[t] = s[display[lev - i.l] + i.a];
+                break;
+        }
+        continue;
+        
+    osr:
+        /* ǰ¼ڻִе */
+        nosr++;
+        r->t = t;
+        r->b = b;
+        r->lev = lev;
+        jit_enter(p, s, display, r);
+        t = r->t;
+        b = r->b;
+        p = s[t + 3];
+        if (depth == 0) {
+            return;
+        }
+        depth--;
+        lev = r->lev - 1 + code[p - 1].l;
+    }
+    
+#undef BACKEDGE
+}
+
+/* δḶ́pִеù̷ */
+void tier_call(int p, int t, int b, int lev) {
+    tier_regs.t = t;
+    tier_regs.b = b;
+    tier_regs.lev = lev;
+    if (++hot[p] >= tier_threshold && compileproc(p)) {
+        jit_enter(p, s, display, &tier_regs);
+    } else {
+        interp(p, &tier_regs);
+    }
+}
+
+/* ֲִ */
+void run_tier() {
+    struct vmregs r;
+    int k;
+    
+    s = vm_stack;
+    memset(hot, 0, sizeof(hot));
+    for (k = 0; k < cx; k++) {
+        if (code[k].f == CAL) {
+            hot[code[k].a] = -1;    /* ڱǹ */
+        }
+    }
+    findentries();
+    memset(hot, 0, sizeof(hot));
+    ncompiled = nosr = 0;
+    ndispatch = 0;
+    jitok = jit_init(1);
+    
+    r.t = 0;
+    r.b = 1;
+    r.lev = 0;
+    display[0] = 1;
+    interp(0, &r);
+    
+    if (jitok) {
+        jit_free();
+    }
+    vm_dispatch = ndispatch;
+    if (vm_stats) {
+        vm_flush();
+        printf("Tier: %d procedures compiled, %d OSR entries\n", ncompiled, nosr);
+    }
+}
@@ -0,0 +1,381 @@
+/* tos.c - PL/0 ջ */
+
+#include <stdio.h>
+#include "pl0.h"
+
+/*
+ * ջ棺ջھֲxջyջУ
+ * s[]жӦĵԪʱЧ״̬012ʾ˼
+ * ÿ״̬һ״ɱ̽ʱ״̬ıһָ
+ * ״̬ݶҪרŵıt߼ջ
+ * LOD/STOʵǻ¼еıַڲջ֮£뻺ص
+ * CALINTǰѻдs[]غ״̬0
+ */
+
+#if defined(__GNUC__)
+
+/* ԤĲOPRӲ볬ָı嶼չΪĲ */
+enum tosop {
+    T_LIT, T_LOD, T_STO, T_STK, T_RED,
+    T_ADD, T_SUB, T_MUL, T_DIV,
+    T_EQL, T_NEQ, T_LSS, T_GEQ, T_GTR, T_LEQ,
+    T_NEG, T_ODD, T_SHL, T_SHR, T_DVM, T_WRT, T_WRL, T_RET, T_NOP,
+    T_CAL, T_INT, T_JMP, T_JPC,
+    T_JEQ, T_JNE, T_JLT, T_JGE, T_JGT, T_JLE, T_JOD,
+    T_STC,
+    T_UPD_ADD, T_UPD_SUB, T_UPD_MUL, T_UPD_DIV,
+    T_JVV_EQL, T_JVV_NEQ, T_JVV_LSS, T_JVV_GEQ, T_JVV_GTR, T_JVV_LEQ,
+    T_JVC_EQL, T_JVC_NEQ, T_JVC_LSS, T_JVC_GEQ, T_JVC_GTR, T_JVC_LEQ
+};
+
+struct tosinstr {
+    enum tosop op;
+    int l;
+    int a;
+};
+
+static struct tosinstr tscode[CXMAX];
+
+/* OPRӲӦԤ */
+static enum tosop oprmap[] = {
+    T_RET, T_NEG, T_ADD, T_SUB, T_MUL, T_DIV, T_ODD, T_NOP,
+    T_EQL, T_NEQ, T_LSS, T_GEQ, T_GTR, T_LEQ,
+    T_WRT, T_WRL, T_RED
+};
+
+/* code[]Ԥ뵽tscode[] */
+static void predecode() {
+    int k;
+    enum tosop op;
+    
+    for (k = 0; k < cx; k++) {
+        switch (code[k].f) {
+            case LIT: op = T_LIT; break;
+            case LOD: op = T_LOD; break;
+            case STO: op = T_STO; break;
+            case STK: op = T_STK; break;
+            case CAL: op = T_CAL; break;
+            case INT: op = T_INT; break;
+            case JMP: op = T_JMP; break;
+            case JPC: op = T_JPC; break;
+            case JOD: op = T_JOD; break;
+            case SHL: op = T_SHL; break;
+            case SHR: op = T_SHR; break;
+            case DVM: op = T_DVM; break;
+            case STC: op = T_STC; break;
+            case OPR:
+                op = (code[k].a >= 0 && code[k].a <= 16) ? oprmap[code[k].a] : T_NOP;
+                break;
+            case UPD:
+                op = T_UPD_ADD + code[k + 2].a - 2;
+                break;
+            case JVV:
+                op = T_JVV_EQL + code[k + 2].f - JEQ;
+                break;
+            case JVC:
+                op = T_JVC_EQL + code[k + 2].f - JEQ;
+                break;
+            default:  /* JEQ~JLE */
+                op = T_JEQ + code[k].f - JEQ;
+                break;
+        }
+        tscode[k].op = op;
+        tscode[k].l = code[k].l;
+        tscode[k].a = code[k].a;
+    }
+}
+
+/* ״̬Sķɱ˳enum tosopһ */
+#define TAB(S) { \
+    &&s##S##_lit, &&s##S##_lod, &&s##S##_sto, &&s##S##_stk, &&s##S##_red, \
+    &&s##S##_add, &&s##S##_sub, &&s##S##_mul, &&s##S##_div, \
+    &&s##S##_eql, &&s##S##_neq, &&s##S##_lss, &&s##S##_geq, &&s##S##_gtr, &&s##S##_leq, \
+    &&s##S##_neg, &&s##S##_odd, \
+    &&s##S##_shl, &&s##S##_shr, &&s##S##_dvm, &&s##S##_wrt, &&s##S##_wrl, &&s##S##_ret, &&s##S##_nop, \
+    &&s##S##_cal, &&s##S##_int, &&s##S##_jmp, &&s##S##_jpc, \
+    &&s##S##_jeq, &&s##S##_jne, &&s##S##_jlt, &&s##S##_jge, &&s##S##_jgt, &&s##S##_jle, \
+    &&s##S##_jod, \
+    &&s##S##_stc, \
+    &&s##S##_upd_add, &&s##S##_upd_sub, &&s##S##_upd_mul, &&s##S##_upd_div, \
+    &&s##S##_jvv_eql, &&s##S##_jvv_neq, &&s##S##_jvv_lss, \
+    &&s##S##_jvv_geq, &&s##S##_jvv_gtr, &&s##S##_jvv_leq, \
+    &&s##S##_jvc_eql, &&s##S##_jvc_neq, &&s##S##_jvc_lss, \
+    &&s##S##_jvc_geq, &&s##S##_jvc_gtr, &&s##S##_jvc_leq \
+}
+
+/* ջ¼display÷ͬrun_switch() */
+void run_tos() {
+    static void *tab0[] = TAB(0);
+    static void *tab1[] = TAB(1);
+    static void *tab2[] = TAB(2);
+    struct tosinstr *ip;     /* ǰָ */
+    int b = 1;               /* ַĴ */
+    int t = 0;               /* ߼ջ */
+    int lev = 0;             /* ǰ */
+    int display[LEVMAX + 1]; /* ¼ַ */
+    int *s = vm_stack;       /* ջ */
+    int x = 0;               /* ջ */
+    int y = 0;               /* Ĵջ */
+    int c;
+    long long n = 0;         /* ɼ */
+    
+    predecode();
+    
+#define NEXT(S)    goto *tab##S[(n++, ++ip)->op]
+#define JUMP(S, k) goto *tab##S[(n++, ip = tscode + (k))->op]
+#define VAR(k)     s[display[lev - ip[k].l] + ip[k].a]
+    
+    display[0] = b;
+    ip = tscode;
+    JUMP(0, 0);
+    
+    /* ѹջLITLODREAD */
+#define PUSH(name, v) \
+s0_##name: \
+    x = (v); \
+    t++; \
+    NEXT(1); \
+s1_##name: \
+    y = x; \
+    x = (v); \
+    t++; \
+    NEXT(2); \
+s2_##name: \
+    s[t - 1] = y; \
+    y = x; \
+    x = (v); \
+    t++; \
+    NEXT(2);
+    PUSH(lit, ip->a)
+    PUSH(lod, VAR(0))
+    PUSH(red, vm_read())
+#undef PUSH
+    
+    /* ջSTOWRITE */
+#define POP(name, use) \
+s0_##name: \
+    c = s[t--]; \
+    use; \
+    NEXT(0); \
+s1_##name: \
+    c = x; \
+    t--; \
+    use; \
+    NEXT(0); \
+s2_##name: \
+    c = x; \
+    x = y; \
+    t--; \
+    use; \
+    NEXT(1);
+    POP(sto, VAR(0) = c)
+    POP(wrt, vm_write(c))
+#undef POP
+    
+    /* ջջx */
+s0_stk:
+    x = s[t];
+s1_stk:
+    VAR(0) = x;
+    NEXT(1);
+s2_stk:
+    VAR(0) = x;
+    NEXT(2);
+    
+    /* Ԫ㣬x */
+#define BINOP(name, op) \
+s0_##name: \
+    t--; \
+    x = s[t] op s[t + 1]; \
+    NEXT(1); \
+s1_##name: \
+    t--; \
+    x = s[t] op x; \
+    NEXT(1); \
+s2_##name: \
+    t--; \
+    x = y op x; \
+    NEXT(1);
+    BINOP(add, +)
+    BINOP(sub, -)
+    BINOP(mul, *)
+    BINOP(div, /)
+    BINOP(eql, ==)
+    BINOP(neq, !=)
+    BINOP(lss, <)
+    BINOP(geq, >=)
+    BINOP(gtr, >)
+    BINOP(leq, <=)
+#undef BINOP
+    
+    /* һԪ */
+#define UNOP(name, e) \
+s0_##name: \
+    x = s[t]; \
+    x = (e); \
+    NEXT(1); \
+s1_##name: \
+    x = (e); \
+    NEXT(1); \
+s2_##name: \
+    x = (e); \
+    NEXT(2);
+    UNOP(neg, -x)
+    UNOP(odd, x & 1)
+    UNOP(shl, SHLK(x, ip->a))
+    UNOP(shr, SHRK(x, ip->a))
+    UNOP(dvm, DIVM(x, ip->a, ip->l))
+#undef UNOP
+    
+    /* ջתJPCJOD */
+#define POPJ(name, cond) \
+s0_##name: \
+    c = s[t--]; \
+    if (cond) { \
+        JUMP(0, ip->a); \
+    } \
+    NEXT(0); \
+s1_##name: \
+    c = x; \
+    t--; \
+    if (cond) { \
+        JUMP(0, ip->a); \
+    } \
+    NEXT(0); \
+s2_##name: \
+    c = x; \
+    x = y; \
+    t--; \
+    if (cond) { \
+        JUMP(1, ip->a); \
+    } \
+    NEXT(1);
+    POPJ(jpc, c == 0)
+    POPJ(jod, (c & 1) == ip->l)
+#undef POPJ
+    
+    /* Ƚϲת */
+#define JREL(name, op) \
+s0_##name: \
+    t -= 2; \
+    if (!(s[t + 1] op s[t + 2])) { \
+        JUMP(0, ip->a); \
+    } \
+    NEXT(0); \
+s1_##name: \
+    t -= 2; \
+    if (!(s[t + 1] op x)) { \
+        JUMP(0, ip->a); \
+    } \
+    NEXT(0); \
+s2_##name: \
+    t -= 2; \
+    if (!(y op x)) { \
+        JUMP(0, ip->a); \
+    } \
+    NEXT(0);
+    JREL(jeq, ==)
+    JREL(jne, !=)
+    JREL(jlt, <)
+    JREL(jge, >=)
+    JREL(jgt, >)
+    JREL(jle, <=)
+#undef JREL
+    
+    /* ռǰдػ */
+s2_cal:
+    s[t - 1] = y;
+s1_cal:
+    s[t] = x;
+s0_cal:
+    lev = lev - ip->l + 1;
+    s[t + 1] = display[lev];
+    s[t + 2] = b;
+    s[t + 3] = ip - tscode + 1;
+    b = t + 1;
+    display[lev] = b;
+    JUMP(0, ip->a);
+    
+s2_int:
+    s[t - 1] = y;
+s1_int:
+    s[t] = x;
+s0_int:
+    t += ip->a;
+    NEXT(0);
+    
+    /* ʱջ嶪 */
+s0_ret:
+s1_ret:
+s2_ret:
+    t = b - 1;
+    display[lev] = s[t + 1];
+    b = s[t + 2];
+    if (s[t + 3] == 0) {
+        vm_dispatch = n;
+        return;
+    }
+    ip = tscode + s[t + 3];
+    lev = lev - 1 + ip[-1].l;
+    n++;
+    goto *tab0[ip->op];
+    
+    /* ²ıջ״̬ͬһд */
+#define SAME(S) \
+s##S##_nop: \
+    NEXT(S); \
+s##S##_jmp: \
+    JUMP(S, ip->a); \
+s##S##_wrl: \
+    vm_writeln(); \
+    NEXT(S); \
+s##S##_stc: \
+    VAR(1) = ip->a; \
+    ip += 1; \
+    NEXT(S); \
+    UPD(S, add, +) \
+    UPD(S, sub, -) \
+    UPD(S, mul, *) \
+    UPD(S, div, /) \
+    JCMP(S, jvv_eql, ==, VAR(1)) \
+    JCMP(S, jvv_neq, !=, VAR(1)) \
+    JCMP(S, jvv_lss, <,  VAR(1)) \
+    JCMP(S, jvv_geq, >=, VAR(1)) \
+    JCMP(S, jvv_gtr, >,  VAR(1)) \
+    JCMP(S, jvv_leq, <=, VAR(1)) \
+    JCMP(S, jvc_eql, ==, ip[1].a) \
+    JCMP(S, jvc_neq, !=, ip[1].a) \
+    JCMP(S, jvc_lss, <,  ip[1].a) \
+    JCMP(S, jvc_geq, >=, ip[1].a) \
+    JCMP(S, jvc_gtr, >,  ip[1].a) \
+    JCMP(S, jvc_leq, <=, ip[1].a)
+#define UPD(S, name, op) \
+s##S##_upd_##name: \
+    VAR(3) = VAR(0) op ip[1].a; \
+    ip += 3; \
+    NEXT(S);
+#define JCMP(S, name, op, v) \
+s##S##_##name: \
+    if (VAR(0) op (v)) { \
+        ip += 2; \
+        NEXT(S); \
+    } \
+    JUMP(S, ip[2].a);
+    SAME(0)
+    SAME(1)
+    SAME(2)
+#undef SAME
+#undef UPD
+#undef JCMP
+    
+#undef NEXT
+#undef JUMP
+#undef VAR
+}
+
+#else
+/* ֧computed gotoı˻switch */
+void run_tos() {
+    run_switch();
+}
+#endif
@@ -0,0 +1,277 @@
+/* trace.c - PL/0 켣ʱ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pl0.h"
+
+/*
+ * ִʱԻĿ꣨ѭͷﵽֵѭͷʼ¼
+ * ʵִеָУÿתתƷCAL뱻̼
+ * ¼ֱͬһ¼лصѭͷγһ켣켣Ϊ
+ * ɵֱ߻룬תΪƫ¼ʱ˳ڳڴ
+ * ͡켣ѭڹ̻ʱ¼
+ * ѭͷٳԡ
+ */
+
+static int *s;                    /* ջ */
+static int display[LEVMAX + 1];   /* ¼ַ */
+static int hot[CXMAX];            /* -1ʾ */
+static int trace[CXMAX];          /* ѭͷӦĹ켣ƫƣ-1ʾ */
+static struct traceop rec[TRACEMAX];    /* ڼ¼Ĺ켣 */
+static int nrec;
+static int ntrace, nabort;        /* ͳ */
+static long long nenter;
+
+/* ִ */
+static long long interp() {
+    int p = 0;       /*  */
+    int b = 1;       /* ַĴ */
+    int t = 0;       /* ջĴ */
+    int lev = 0;     /* ǰ */
+    int cur;
+    int recording = 0;       /* ڼ¼ѭͷ0ʾδ¼ */
+    int rlev = 0, rdepth = 0;
+    long long n = 0;
+    struct vmregs r;
+    struct instruction i;
+    
+    display[0] = b;
+    
+    do {
+        cur = p;
+        i = code[p++];
+        n++;
+        if (recording) {
+            rec[nrec].k = cur;
+            rec[nrec++].taken = 0;
+        }
+        
+        switch (i.f) {
+            case LIT:
+                s[++t] = i.a;
+                break;
+                
+            case OPR:
+                switch (i.a) {
+                    case 0:
+                        t = b - 1;
+                        display[lev] = s[t + 1];
+                        p = s[t + 3];
+                        b = s[t + 2];
+                        if (p != 0) {
+                            lev = lev - 1 + code[p - 1].l;
+                        }
+                        rdepth--;
+                        break;
+                    case 1:
+                        s[t] = -s[t];
+                        break;
+                    case 2:
+                        t--;
+                        s[t] = s[t] + s[t + 1];
+                        break;
+                    case 3:
+                        t--;
+                        s[t] = s[t] - s[t + 1];
+                        break;
+                    case 4:
+                        t--;
+                        s[t] = s[t] * s[t + 1];
+                        break;
+                    case 5:
+                        t--;
+                        s[t] = s[t] / s[t + 1];
+                        break;
+                    case 6:
+                        s[t] = s[t] & 1;
+                        break;
+                    case 8:
+                        t--;
+                        s[t] = (s[t] == s[t + 1]);
+                        break;
+                    case 9:
+                        t--;
+                        s[t] = (s[t] != s[t + 1]);
+                        break;
+                    case 10:
+                        t--;
+                        s[t] = (s[t] < s[t + 1]);
+                        break;
+                    case 11:
+                        t--;
+                        s[t] = (s[t] >= s[t + 1]);
+                        break;
+                    case 12:
+                        t--;
+                        s[t] = (s[t] > s[t + 1]);
+                        break;
+                    case 13:
+                        t--;
+                        s[t] = (s[t] <= s[t + 1]);
+                        break;
+                    case 14:
+                        vm_write(s[t]);
+                        t--;
+                        break;
+                    case 15:
+                        vm_writeln();
+                        break;
+                    case 16:
+                        t++;
+                        s[t] = vm_read();
+                        break;
+                }
+                break;
+                
+            case LOD:
+                t++;
+                s[t] = s[display[lev - i.l] + i.a];
+                break;
+                
+            case STO:
+                s[display[lev - i.l] + i.a] = s[t];
+                t--;
+                break;
+                
+            case CAL:
+                lev = lev - i.l + 1;
+                s[t + 1] = display[lev];
+                s[t + 2] = b;
+                s[t + 3] = p;
+                b = t + 1;
+                display[lev] = b;
+                p = i.a;
+                rdepth++;
+                break;
+                
+            case INT:
+                t += i.a;
+                break;
+                
+            case JMP:
+                p = i.a;
+                break;
+                
+            case JPC:
+                if (s[t] == 0) {
+                    p = i.a;
+                }
+                t--;
+                break;
+                
+            case JEQ: case JNE: case JLT: case JGE: case JGT: case JLE:
+                t -= 2;
+                if (!(i.f == JEQ ? s[t + 1] == s[t + 2] :
+                      i.f == JNE ? s[t + 1] != s[t + 2] :
+                      i.f == JLT ? s[t + 1] < s[t + 2] :
+                      i.f == JGE ? s[t + 1] >= s[t + 2] :
+                      i.f == JGT ? s[t + 1] > s[t + 2] : s[t + 1] <= s[t + 2])) {
+                    p = i.a;
+                }
+                break;
+                
+            case JOD:
+                if ((s[t] & 1) == i.l) {
+                    p = i.a;
+                }
+                t--;
+                break;
+                
+            case STK:
+                s[display[lev - i.l] + i.a] = s[t];
+                break;
+                
+            case SHL:
+                s[t] = SHLK(s[t], i.a);
+                break;
+                
+            case SHR:
+                s[t] = SHRK(s[t], i.a);
+                break;
+                
+            case DVM:
+                s[t] = DIVM(s[t], i.a, i.l);
+                break;
+                
+            case STC:
+                /* ָԭִָУָȻ */
+                s[++t] = i.a;
+                break;
+                
+            case UPD: case JVV: case JVC:
+                t++;
+                s[t] = s[display[lev - i.l] + i.a];
+                break;
+        }
+        
+        if (recording) {
+            if (i.f >= JPC && i.f <= JOD) {
+                rec[nrec - 1].taken = (p != cur + 1);
+            }
+            if (p == recording && rdepth == 0) {
+                /* صѭͷ켣պ */
+                trace[p] = jit_trace(rec, nrec, rlev);
+                if (trace[p] >= 0) {
+                    ntrace++;
+                    if (vm_stats) {
+                        vm_flush();
+                        printf("Trace: loop at %d, %d instructions\n", p, nrec);
+                    }
+                } else {
+                    hot[p] = -1;
+                    nabort++;
+                }
+                recording = 0;
+            } else if (nrec == TRACEMAX || rdepth < 0 || p == 0) {
+                hot[recording] = -1;
+                nabort++;
+                recording = 0;
+            }
+        } else if (i.f >= JMP && i.f <= JOD && p <= cur) {
+            /* й켣ִУ */
+            if (trace[p] >= 0) {
+                nenter++;
+                r.t = t;
+                r.b = b;
+                r.lev = lev;
+                p = jit_run_trace(trace[p], s, display, &r);
+                t = r.t;
+                b = r.b;
+                lev = r.lev;
+            } else if (hot[p] >= 0 && ++hot[p] == tier_threshold) {
+                recording = p;
+                rlev = lev;
+                rdepth = 0;
+                nrec = 0;
+            }
+        }
+    } while (p != 0);
+    
+    return n;
+}
+
+/* 켣ʱִ */
+void run_trace() {
+    int ok;
+    
+    s = vm_stack;
+    memset(hot, 0, sizeof(hot));
+    memset(trace, -1, sizeof(trace));
+    ntrace = nabort = 0;
+    nenter = 0;
+    ok = jit_init(0);
+    if (!ok) {
+        /* ûмʱʱ¼ */
+        memset(hot, -1, sizeof(hot));
+    }
+    
+    vm_dispatch = interp();
+    
+    if (ok) {
+        jit_free();
+    }
+    if (vm_stats) {
+        vm_flush();
+        printf("Trace: %d compiled, %d aborted, %lld entries\n", ntrace, nabort, nenter);
+    }
+}